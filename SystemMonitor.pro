@@ -2,7 +2,7 @@ QT       += core gui
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
-CONFIG += c++11
+CONFIG += c++14
 
 # You can make your code fail to compile if it uses deprecated APIs.
 # In order to do so, uncomment the following line.
@@ -11,26 +11,91 @@ CONFIG += c++11
 SOURCES += \
     main.cpp \
     src/controller/appcontroller.cpp \
+    src/controller/datacontroller.cpp \
+    src/core/cgroupparser.cpp \
+    src/core/diskstatsparser.cpp \
+    src/core/meminfoparser.cpp \
+    src/core/metricblock.cpp \
+    src/core/metricjournal.cpp \
+    src/core/metricstore.cpp \
+    src/core/mountparser.cpp \
+    src/core/mountprober.cpp \
+    src/core/netdevparser.cpp \
+    src/core/netlinkstats.cpp \
+    src/core/procfilereader.cpp \
+    src/core/procpidparser.cpp \
+    src/core/procstatparser.cpp \
+    src/core/psiparser.cpp \
     src/core/systemUtils.cpp \
     src/model/base/basemonitor.cpp \
+    src/model/base/samplerthread.cpp \
+    src/model/corepowertracker.cpp \
+    src/model/cgroupmonitor.cpp \
     src/model/cpumonitor.cpp \
+    src/model/linkwatcher.cpp \
     src/model/memorymonitor.cpp \
     src/model/networkmonitor.cpp \
+    src/model/processcolumnstore.cpp \
+    src/model/pressuremonitor.cpp \
+    src/model/pressurewatcher.cpp \
+    src/model/processmonitor.cpp \
+    src/model/sensormonitor.cpp \
+    src/model/storagemonitor.cpp \
+    src/model/topktracker.cpp \
     src/view/dashboardwidget.cpp \
     src/view/mainwindow.cpp \
+    src/view/processtablemodel.cpp \
+    src/view/processtablewidget.cpp \
+    src/view/topprocessmodel.cpp \
+    src/view/topprocesseswidget.cpp \
     src/view/widgets/circularprogress.cpp \
     src/view/widgets/metriccard.cpp
 
 HEADERS += \
     src/controller/appcontroller.h \
+    src/controller/datacontroller.h \
     src/core/constants.h \
+    src/core/cpuusagekernel.h \
+    src/core/byteview.h \
+    src/core/cgroupparser.h \
+    src/core/diskstatsparser.h \
+    src/core/meminfoparser.h \
+    src/core/metricblock.h \
+    src/core/metricjournal.h \
+    src/core/metricstore.h \
+    src/core/mountparser.h \
+    src/core/mountprober.h \
+    src/core/netdevparser.h \
+    src/core/netlinkstats.h \
+    src/core/procfilereader.h \
+    src/core/procpidparser.h \
+    src/core/procstatparser.h \
+    src/core/psiparser.h \
+    src/core/ringbuffer.h \
+    src/core/sampletime.h \
+    src/core/slidingwindow.h \
     src/core/systemUtils.h \
     src/model/base/basemonitor.h \
+    src/model/base/samplerthread.h \
+    src/model/corepowertracker.h \
+    src/model/cgroupmonitor.h \
     src/model/cpumonitor.h \
+    src/model/linkwatcher.h \
     src/model/memorymonitor.h \
     src/model/networkmonitor.h \
+    src/model/processcolumnstore.h \
+    src/model/pressuremonitor.h \
+    src/model/pressurewatcher.h \
+    src/model/processmonitor.h \
+    src/model/sensormonitor.h \
+    src/model/storagemonitor.h \
+    src/model/topktracker.h \
     src/view/dashboardwidget.h \
     src/view/mainwindow.h \
+    src/view/processtablemodel.h \
+    src/view/processtablewidget.h \
+    src/view/topprocessmodel.h \
+    src/view/topprocesseswidget.h \
     src/view/widgets/circularprogress.h \
     src/view/widgets/metriccard.h
 
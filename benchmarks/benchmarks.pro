@@ -0,0 +1,8 @@
+# Standalone benchmarks, built apart from the application:
+#   qmake benchmarks/benchmarks.pro && make
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    metricblock \
+    netlinkstats \
+    procfilereader
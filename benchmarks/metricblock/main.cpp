@@ -0,0 +1,472 @@
+// Compression ratio and encode/decode throughput of the MetricStore's
+// Gorilla blocks on recorded /proc traces.
+//
+//   metricblock_bench record <trace> <seconds>    sample /proc once a second
+//   metricblock_bench <trace> [<trace> ...]       encode and decode every series
+//
+// A trace is plain text, one "<timestamp ms> <series> <value>" line per
+// point. The recorder stamps phase-aligned 1 s ticks and writes the kind of
+// headline values the monitors feed into the MetricStore, so the ratios are
+// those of real history rather than synthetic curves.
+
+#include "constants.h"
+#include "diskstatsparser.h"
+#include "meminfoparser.h"
+#include "metricblock.h"
+#include "netdevparser.h"
+#include "procfilereader.h"
+#include "procstatparser.h"
+#include "psiparser.h"
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QtAlgorithms>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
+
+namespace {
+    const int MAX_CORES = 1024;
+    const double SECTOR_SIZE = 512.0;
+
+    struct Point {
+        qint64 timestamp;
+        double value;
+    };
+
+    struct Series {
+        QString name;
+        QVector<Point> points;
+    };
+
+    qint64 nowMs()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        return qint64(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+    }
+
+    double percent(quint64 part, quint64 whole)
+    {
+        return whole > 0 ? double(part) * 100.0 / double(whole) : 0.0;
+    }
+
+    // --- Recording ---------------------------------------------------------
+
+    class Recorder
+    {
+    public:
+        Recorder()
+            : m_stat(Constants::PROC_STAT)
+            , m_meminfo(Constants::PROC_MEMINFO)
+            , m_netDev(Constants::PROC_NET_DEV)
+            , m_diskstats(Constants::PROC_DISKSTATS)
+            , m_coreTotal(MAX_CORES)
+            , m_coreIdle(MAX_CORES)
+        {
+            const char *resources[] = { "cpu", "memory", "io" };
+            for (int i = 0; i < 3; ++i) {
+                m_pressure[i].setPath(Constants::PROC_PRESSURE_DIR + "/" + resources[i]);
+            }
+        }
+
+        void sample(qint64 timestamp, std::FILE *out)
+        {
+            m_out = out;
+            m_timestamp = timestamp;
+
+            sampleCpu();
+            sampleMemory();
+            sampleNetwork();
+            sampleDisks();
+            samplePressure();
+
+            m_first = false;
+        }
+
+    private:
+        void write(const char *name, double value)
+        {
+            std::fprintf(m_out, "%lld %s %.17g\n", static_cast<long long>(m_timestamp), name, value);
+        }
+
+        void sampleCpu()
+        {
+            ProcStatData stat;
+            if (!ProcStatParser::parse(m_stat.read(), stat, m_coreTotal.data(), m_coreIdle.data(), MAX_CORES)) {
+                return;
+            }
+
+            if (!m_first) {
+                const quint64 total = stat.cpu.total() - m_prevStat.cpu.total();
+                const quint64 idle = stat.cpu.idleTotal() - m_prevStat.cpu.idleTotal();
+                write("cpu.usage", percent(total - idle, total));
+
+                char name[32];
+                for (int i = 0; i < qMin(stat.coreCount, MAX_CORES); ++i) {
+                    const quint64 coreTotal = m_coreTotal[i] - m_prevCoreTotal[i];
+                    const quint64 coreIdle = m_coreIdle[i] - m_prevCoreIdle[i];
+                    std::snprintf(name, sizeof(name), "cpu.core%d", i);
+                    write(name, percent(coreTotal - coreIdle, coreTotal));
+                }
+
+                write("cpu.procs_running", stat.procsRunning);
+                write("cpu.context_switches", double(stat.contextSwitches - m_prevStat.contextSwitches));
+            }
+
+            m_prevStat = stat;
+            m_prevCoreTotal = m_coreTotal;
+            m_prevCoreIdle = m_coreIdle;
+        }
+
+        void sampleMemory()
+        {
+            MeminfoData info;
+            if (!MeminfoParser::parse(m_meminfo.read(), info)) {
+                return;
+            }
+
+            const qint64 total = info.value(MeminfoData::MemTotal);
+            const qint64 swap = info.value(MeminfoData::SwapTotal);
+            write("memory.usage", percent(quint64(total - info.value(MeminfoData::MemAvailable)), quint64(total)));
+            write("memory.swap", percent(quint64(swap - info.value(MeminfoData::SwapFree)), quint64(swap)));
+            write("memory.commit", percent(quint64(info.value(MeminfoData::CommittedAS)),
+                                           quint64(info.value(MeminfoData::CommitLimit))));
+            write("memory.dirty_kb", double(info.value(MeminfoData::Dirty)));
+        }
+
+        void sampleNetwork()
+        {
+            QVector<InterfaceCounters> counters;
+            if (NetDevParser::parse(m_netDev.read(), counters) <= 0) {
+                return;
+            }
+
+            char name[64];
+            for (const InterfaceCounters &cur : counters) {
+                for (const InterfaceCounters &prev : m_prevNet) {
+                    if (std::strcmp(cur.name, prev.name) != 0) {
+                        continue;
+                    }
+                    std::snprintf(name, sizeof(name), "network.%s.download", cur.name);
+                    write(name, NetDevParser::counterDelta(cur.rxBytes, prev.rxBytes) / Constants::BYTES_PER_MB);
+                    std::snprintf(name, sizeof(name), "network.%s.upload", cur.name);
+                    write(name, NetDevParser::counterDelta(cur.txBytes, prev.txBytes) / Constants::BYTES_PER_MB);
+                }
+            }
+            m_prevNet = counters;
+        }
+
+        void sampleDisks()
+        {
+            QVector<DiskCounters> counters;
+            if (DiskStatsParser::parse(m_diskstats.read(), counters) <= 0) {
+                return;
+            }
+
+            char name[64];
+            for (const DiskCounters &cur : counters) {
+                if (std::strncmp(cur.name, "loop", 4) == 0 || std::strncmp(cur.name, "ram", 3) == 0) {
+                    continue;
+                }
+                for (const DiskCounters &prev : m_prevDisks) {
+                    if (std::strcmp(cur.name, prev.name) != 0) {
+                        continue;
+                    }
+                    std::snprintf(name, sizeof(name), "storage.%s.read", cur.name);
+                    write(name, (cur.sectorsRead - prev.sectorsRead) * SECTOR_SIZE);
+                    std::snprintf(name, sizeof(name), "storage.%s.write", cur.name);
+                    write(name, (cur.sectorsWritten - prev.sectorsWritten) * SECTOR_SIZE);
+                    std::snprintf(name, sizeof(name), "storage.%s.utilization", cur.name);
+                    write(name, qMin(100.0, (cur.ioTimeMs - prev.ioTimeMs) / 10.0));
+                }
+            }
+            m_prevDisks = counters;
+        }
+
+        void samplePressure()
+        {
+            const char *names[] = { "pressure.cpu", "pressure.memory", "pressure.io" };
+            for (int i = 0; i < 3; ++i) {
+                PressureStats stats;
+                if (PsiParser::parse(m_pressure[i].read(), stats)) {
+                    write(names[i], stats.some.avg10);
+                }
+            }
+        }
+
+        ProcFileReader m_stat;
+        ProcFileReader m_meminfo;
+        ProcFileReader m_netDev;
+        ProcFileReader m_diskstats;
+        ProcFileReader m_pressure[3];
+
+        QVector<quint64> m_coreTotal;
+        QVector<quint64> m_coreIdle;
+        QVector<quint64> m_prevCoreTotal;
+        QVector<quint64> m_prevCoreIdle;
+        ProcStatData m_prevStat;
+        QVector<InterfaceCounters> m_prevNet;
+        QVector<DiskCounters> m_prevDisks;
+
+        std::FILE *m_out = nullptr;
+        qint64 m_timestamp = 0;
+        bool m_first = true;
+    };
+
+    int record(const char *path, int seconds)
+    {
+        std::FILE *out = std::fopen(path, "w");
+        if (!out) {
+            std::perror(path);
+            return 1;
+        }
+
+        // Same phase alignment as DataController::scheduleNextTick()
+        const qint64 tick = Constants::UPDATE_INTERVAL;
+        Recorder recorder;
+        for (int i = 0; i <= seconds; ++i) {
+            const qint64 now = nowMs();
+            const qint64 next = (now / tick + 1) * tick;
+            ::usleep(useconds_t((next - now) * 1000));
+
+            recorder.sample(next, out);
+            std::fflush(out);
+        }
+
+        std::fclose(out);
+        return 0;
+    }
+
+    // --- Benchmark ---------------------------------------------------------
+
+    bool load(const char *path, QVector<Series> &series, QHash<QString, int> &index)
+    {
+        std::FILE *in = std::fopen(path, "r");
+        if (!in) {
+            std::perror(path);
+            return false;
+        }
+
+        long long timestamp;
+        char name[256];
+        double value;
+        while (std::fscanf(in, "%lld %255s %lf", &timestamp, name, &value) == 3) {
+            const QString key = QString::fromLatin1(name);
+            int i = index.value(key, -1);
+            if (i < 0) {
+                i = series.size();
+                index.insert(key, i);
+                Series created;
+                created.name = key;
+                series.append(created);
+            }
+
+            Point point = { timestamp, value };
+            series[i].points.append(point);
+        }
+
+        std::fclose(in);
+        return true;
+    }
+
+    // Same bucketing as MetricStore::appendLocked()
+    QVector<MetricBucket> rollup(const QVector<Point> &points, qint64 width)
+    {
+        QVector<MetricBucket> buckets;
+        MetricBucket open;
+        double sum = 0.0;
+
+        for (const Point &point : points) {
+            const qint64 start = point.timestamp - point.timestamp % width;
+            if (open.count > 0 && open.timestamp != start) {
+                open.mean = float(sum / open.count);
+                buckets.append(open);
+                open = MetricBucket();
+                sum = 0.0;
+            }
+
+            if (open.count == 0) {
+                open.timestamp = start;
+                open.min = open.max = float(point.value);
+            } else {
+                open.min = qMin(open.min, float(point.value));
+                open.max = qMax(open.max, float(point.value));
+            }
+            sum += point.value;
+            ++open.count;
+        }
+        return buckets;
+    }
+
+    QVector<MetricBucket> rawPoints(const QVector<Point> &points)
+    {
+        QVector<MetricBucket> buckets;
+        buckets.reserve(points.size());
+        for (const Point &point : points) {
+            MetricBucket bucket;
+            bucket.timestamp = point.timestamp;
+            bucket.min = bucket.max = bucket.mean = float(point.value);
+            bucket.count = 1;
+            buckets.append(bucket);
+        }
+        return buckets;
+    }
+
+    // Encodes in METRIC_BLOCK_POINTS blocks like the store; returns the bytes
+    qint64 encode(const QVector<MetricBucket> &points, MetricBlockEncoder &encoder, QVector<MetricBlock> *blocks)
+    {
+        qint64 bytes = 0;
+        encoder.clear();
+        for (int i = 0; i < points.size(); ++i) {
+            encoder.append(points[i]);
+            if (encoder.count() == Constants::METRIC_BLOCK_POINTS || i == points.size() - 1) {
+                bytes += encoder.data().size();
+                if (blocks) {
+                    blocks->append(encoder.seal());
+                }
+                encoder.clear();
+            }
+        }
+        return bytes;
+    }
+
+    bool sameBucket(const MetricBucket &a, const MetricBucket &b)
+    {
+        return a.timestamp == b.timestamp && a.count == b.count &&
+               std::memcmp(&a.min, &b.min, sizeof(float)) == 0 &&
+               std::memcmp(&a.max, &b.max, sizeof(float)) == 0 &&
+               std::memcmp(&a.mean, &b.mean, sizeof(float)) == 0;
+    }
+
+    int benchmark(const QVector<Series> &series)
+    {
+        QVector<QVector<MetricBucket>> raw;
+        QVector<QVector<MetricBucket>> medium;
+        for (const Series &s : series) {
+            raw.append(rawPoints(s.points));
+            medium.append(rollup(s.points, Constants::METRIC_MEDIUM_RESOLUTION));
+        }
+
+        // Ratio per series, and a round trip check of every block
+        MetricBlockEncoder encoder;
+        qint64 rawPointCount = 0;
+        qint64 rawBytes = 0;
+        qint64 mediumPointCount = 0;
+        qint64 mediumBytes = 0;
+        QVector<QVector<MetricBlock>> blocks(series.size());
+
+        std::printf("%-36s %8s %10s %10s\n", "series", "points", "bytes/pt", "vs double");
+        for (int i = 0; i < series.size(); ++i) {
+            const qint64 bytes = encode(raw[i], encoder, &blocks[i]);
+            rawPointCount += raw[i].size();
+            rawBytes += bytes;
+            mediumPointCount += medium[i].size();
+            mediumBytes += encode(medium[i], encoder, nullptr);
+
+            const double perPoint = raw[i].isEmpty() ? 0.0 : double(bytes) / raw[i].size();
+            std::printf("%-36s %8d %10.2f %9.1fx\n", series[i].name.toLatin1().constData(),
+                        raw[i].size(), perPoint, perPoint > 0 ? 8.0 / perPoint : 0.0);
+
+            int p = 0;
+            for (const MetricBlock &block : blocks[i]) {
+                MetricBlockDecoder decoder(block.data, block.count);
+                MetricBucket point;
+                while (decoder.next(point)) {
+                    if (!sameBucket(point, raw[i][p++])) {
+                        std::printf("round trip mismatch in %s at point %d\n",
+                                    series[i].name.toLatin1().constData(), p - 1);
+                        return 1;
+                    }
+                }
+            }
+        }
+
+        if (rawPointCount == 0) {
+            std::printf("no points\n");
+            return 1;
+        }
+
+        const double rawPerPoint = double(rawBytes) / rawPointCount;
+        std::printf("\nraw:    %lld points, %.2f bytes/point - %.1fx vs 8 B double, %.1fx vs 16 B "
+                    "timestamp + double, %.1fx vs %d B MetricBucket\n",
+                    static_cast<long long>(rawPointCount), rawPerPoint, 8.0 / rawPerPoint,
+                    16.0 / rawPerPoint, sizeof(MetricBucket) / rawPerPoint, int(sizeof(MetricBucket)));
+        if (mediumPointCount > 0) {
+            const double mediumPerPoint = double(mediumBytes) / mediumPointCount;
+            std::printf("10 s:   %lld buckets, %.2f bytes/bucket - %.1fx vs %d B MetricBucket\n",
+                        static_cast<long long>(mediumPointCount), mediumPerPoint,
+                        sizeof(MetricBucket) / mediumPerPoint, int(sizeof(MetricBucket)));
+        }
+
+        // Throughput: repeat until each side ran for a while
+        const qint64 minimumNs = 500000000;
+        QElapsedTimer timer;
+
+        qint64 encoded = 0;
+        timer.start();
+        do {
+            for (const QVector<MetricBucket> &points : raw) {
+                encode(points, encoder, nullptr);
+                encoded += points.size();
+            }
+        } while (timer.nsecsElapsed() < minimumNs);
+        const double encodeRate = encoded * 1e3 / timer.nsecsElapsed();
+
+        qint64 decoded = 0;
+        double checksum = 0.0;
+        timer.start();
+        do {
+            for (const QVector<MetricBlock> &seriesBlocks : blocks) {
+                for (const MetricBlock &block : seriesBlocks) {
+                    MetricBlockDecoder decoder(block.data, block.count);
+                    MetricBucket point;
+                    while (decoder.next(point)) {
+                        checksum += point.mean;
+                        ++decoded;
+                    }
+                }
+            }
+        } while (timer.nsecsElapsed() < minimumNs);
+        const double decodeRate = decoded * 1e3 / timer.nsecsElapsed();
+
+        std::printf("encode: %.1f M points/s\ndecode: %.1f M points/s (checksum %g)\n",
+                    encodeRate, decodeRate, checksum);
+        return 0;
+    }
+
+    void usage()
+    {
+        std::printf("usage: metricblock_bench record <trace> <seconds>\n"
+                    "       metricblock_bench <trace> [<trace> ...]\n");
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+
+    if (std::strcmp(argv[1], "record") == 0) {
+        if (argc != 4 || std::atoi(argv[3]) <= 0) {
+            usage();
+            return 1;
+        }
+        return record(argv[2], std::atoi(argv[3]));
+    }
+
+    QVector<Series> series;
+    QHash<QString, int> index;
+    for (int i = 1; i < argc; ++i) {
+        if (!load(argv[i], series, index)) {
+            return 1;
+        }
+    }
+    return benchmark(series);
+}
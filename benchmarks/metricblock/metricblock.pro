@@ -0,0 +1,24 @@
+QT       -= gui
+QT       += core
+
+CONFIG += c++14 console
+CONFIG -= app_bundle
+
+TARGET = metricblock_bench
+
+INCLUDEPATH += ../../src/core
+
+SOURCES += \
+    main.cpp \
+    ../../src/core/diskstatsparser.cpp \
+    ../../src/core/meminfoparser.cpp \
+    ../../src/core/metricblock.cpp \
+    ../../src/core/netdevparser.cpp \
+    ../../src/core/procfilereader.cpp \
+    ../../src/core/procstatparser.cpp \
+    ../../src/core/psiparser.cpp
+
+HEADERS += \
+    ../../src/core/byteview.h \
+    ../../src/core/constants.h \
+    ../../src/core/metricblock.h
@@ -0,0 +1,26 @@
+QT       -= gui
+QT       += core
+
+CONFIG += c++14 console
+CONFIG -= app_bundle
+
+TARGET = netlinkstats_bench
+
+INCLUDEPATH += ../../src/core
+
+SOURCES += \
+    main.cpp \
+    ../../src/core/netdevparser.cpp \
+    ../../src/core/netlinkstats.cpp \
+    ../../src/core/procfilereader.cpp
+
+HEADERS += \
+    ../../src/core/byteview.h \
+    ../../src/core/constants.h \
+    ../../src/core/netdevparser.h \
+    ../../src/core/netlinkstats.h \
+    ../../src/core/procfilereader.h
+
+# Creates the namespaces and runs the benchmark in them
+DISTFILES += \
+    run-netns.sh
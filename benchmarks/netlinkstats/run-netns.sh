@@ -0,0 +1,45 @@
+#!/bin/sh
+# Runs netlinkstats_bench in throwaway network namespaces holding 1k and 10k
+# links (dummy where the module is available, veth pairs otherwise), so
+# both backends see exactly that many interfaces. Needs root.
+#
+#   ./run-netns.sh <path to netlinkstats_bench> [link counts...]
+
+set -e
+
+if [ $# -lt 1 ]; then
+    echo "usage: $0 <netlinkstats_bench> [link counts...]" >&2
+    exit 1
+fi
+
+bench=$(readlink -f "$1")
+shift
+counts=${*:-"1000 10000"}
+
+for count in $counts; do
+    unshare --net sh -e -c '
+        count=$1
+        bench=$2
+        batch=$(mktemp)
+        trap "rm -f $batch" EXIT
+
+        if ip link add bench0 type dummy 2>/dev/null; then
+            ip link del bench0
+            i=0
+            while [ $i -lt $count ]; do
+                echo "link add bench$i type dummy"
+                i=$((i + 1))
+            done > "$batch"
+        else
+            i=0
+            while [ $((i * 2)) -lt $count ]; do
+                echo "link add bench${i}a type veth peer name bench${i}b"
+                i=$((i + 1))
+            done > "$batch"
+        fi
+
+        ip -batch "$batch"
+        ip link set lo up
+        "$bench" $((10000000 / count))
+    ' sh "$count" "$bench"
+done
@@ -0,0 +1,150 @@
+// ProcFileReader against the SystemUtils::readFile path it replaced, on the
+// files the monitors read every tick.
+//
+//   procfilereader_bench [iterations]
+//
+// Reports wall time and heap allocations per read. Syscalls per read are
+// best counted from outside: strace -c -e trace=%file,%desc procfilereader_bench 1000
+
+#include "constants.h"
+#include "meminfoparser.h"
+#include "procfilereader.h"
+#include "procstatparser.h"
+#include "systemUtils.h"
+#include <QElapsedTimer>
+#include <QString>
+#include <QStringList>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+// Every heap allocation of the process goes through these (glibc)
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *ptr, size_t size);
+
+namespace {
+    quint64 s_allocations = 0;
+}
+
+extern "C" void *malloc(size_t size)
+{
+    ++s_allocations;
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size)
+{
+    ++s_allocations;
+    return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size)
+{
+    ++s_allocations;
+    return __libc_realloc(ptr, size);
+}
+
+namespace {
+    struct Result {
+        double nsPerRead = 0.0;
+        double allocationsPerRead = 0.0;
+        qint64 bytes = 0;
+    };
+
+    template <typename ReadFn>
+    Result measure(int iterations, ReadFn read)
+    {
+        Result result;
+        read();     // Warm up: first open, buffer growth
+
+        const quint64 allocations = s_allocations;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < iterations; ++i) {
+            result.bytes += read();
+        }
+        result.nsPerRead = double(timer.nsecsElapsed()) / iterations;
+        result.allocationsPerRead = double(s_allocations - allocations) / iterations;
+        return result;
+    }
+
+    // Old path: QFile + QTextStream into a UTF-16 QString, every call
+    Result measureReadFile(const QString &path, int iterations)
+    {
+        return measure(iterations, [&path]() -> qint64 {
+            return SystemUtils::readFile(path).size();
+        });
+    }
+
+    // New path: persistent descriptor, pread() into the reused buffer
+    Result measureReader(const QString &path, int iterations)
+    {
+        ProcFileReader reader(path);
+        return measure(iterations, [&reader]() -> qint64 {
+            return reader.read().size;
+        });
+    }
+
+    // What CPUMonitor/MemoryMonitor do with the bytes, for a per-tick figure
+    Result measureParse(int iterations)
+    {
+        ProcFileReader stat(Constants::PROC_STAT);
+        ProcFileReader meminfo(Constants::PROC_MEMINFO);
+        ProcStatData statData;
+        MeminfoData meminfoData;
+        return measure(iterations, [&]() -> qint64 {
+            ProcStatParser::parse(stat.read(), statData);
+            MeminfoParser::parse(meminfo.read(), meminfoData);
+            return statData.coreCount + meminfoData.value(MeminfoData::MemTotal);
+        });
+    }
+
+    void print(const char *label, const Result &result)
+    {
+        std::printf("  %-14s %9.2f us/read %8.1f allocs/read\n", label,
+                    result.nsPerRead / 1000.0, result.allocationsPerRead);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 20000;
+    if (iterations <= 0) {
+        std::printf("usage: procfilereader_bench [iterations]\n");
+        return 1;
+    }
+
+    const QStringList paths = QStringList()
+        << Constants::PROC_STAT
+        << Constants::PROC_MEMINFO
+        << Constants::PROC_NET_DEV
+        << Constants::SYS_THERMAL_DIR + "/thermal_zone0/temp"
+        << Constants::SYS_CPU_DIR + "/cpu0/cpufreq/scaling_cur_freq";
+
+    std::printf("%d iterations per file\n", iterations);
+
+    double oldTotal = 0.0;
+    double newTotal = 0.0;
+    for (const QString &path : paths) {
+        if (::access(path.toLocal8Bit().constData(), R_OK) != 0) {
+            std::printf("%s: not readable, skipped\n", path.toLocal8Bit().constData());
+            continue;
+        }
+
+        const Result old = measureReadFile(path, iterations);
+        const Result current = measureReader(path, iterations);
+        oldTotal += old.nsPerRead;
+        newTotal += current.nsPerRead;
+
+        std::printf("%s\n", path.toLocal8Bit().constData());
+        print("readFile", old);
+        print("ProcFileReader", current);
+        std::printf("  speedup        %9.1fx\n", current.nsPerRead > 0 ? old.nsPerRead / current.nsPerRead : 0.0);
+    }
+
+    std::printf("all files: readFile %.2f us, ProcFileReader %.2f us per tick\n",
+                oldTotal / 1000.0, newTotal / 1000.0);
+    print("stat+meminfo parse", measureParse(iterations));
+    return 0;
+}
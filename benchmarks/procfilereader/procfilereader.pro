@@ -0,0 +1,22 @@
+QT       -= gui
+QT       += core
+
+CONFIG += c++14 console
+CONFIG -= app_bundle
+
+TARGET = procfilereader_bench
+
+INCLUDEPATH += ../../src/core
+
+SOURCES += \
+    main.cpp \
+    ../../src/core/meminfoparser.cpp \
+    ../../src/core/procfilereader.cpp \
+    ../../src/core/procstatparser.cpp \
+    ../../src/core/systemUtils.cpp
+
+HEADERS += \
+    ../../src/core/byteview.h \
+    ../../src/core/constants.h \
+    ../../src/core/procfilereader.h \
+    ../../src/core/systemUtils.h
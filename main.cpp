@@ -7,8 +7,15 @@
 #include "src/model/cpumonitor.h"
 #include "src/model/memorymonitor.h"
 #include "src/model/networkmonitor.h"
+#include "src/model/processmonitor.h"
+#include "src/model/storagemonitor.h"
+#include "src/model/sensormonitor.h"
+#include "src/model/pressuremonitor.h"
+#include "src/model/cgroupmonitor.h"
 #include "src/core/constants.h"
 #include "src/view/mainwindow.h"
+#include "src/view/topprocesseswidget.h"
+#include "src/view/processtablewidget.h"
 
 int main(int argc, char *argv[])
 {
@@ -23,6 +30,11 @@ int main(int argc, char *argv[])
     CPUMonitor *cpuMonitor = new CPUMonitor(&app);
     MemoryMonitor *memoryMonitor = new MemoryMonitor(&app);
     NetworkMonitor *networkMonitor = new NetworkMonitor(&app);
+    ProcessMonitor *processMonitor = new ProcessMonitor(&app);
+    StorageMonitor *storageMonitor = new StorageMonitor(&app);
+    SensorMonitor *sensorMonitor = new SensorMonitor(&app);
+    PressureMonitor *pressureMonitor = new PressureMonitor(&app);
+    CgroupMonitor *cgroupMonitor = new CgroupMonitor(&app);
 
     // Connect to AppController ready signal
     QObject::connect(appController, &AppController::applicationReady, [=]() {
@@ -46,11 +58,21 @@ int main(int argc, char *argv[])
         dashboard->connectCPUMonitor(cpuMonitor);
         dashboard->connectMemoryMonitor(memoryMonitor);
         dashboard->connectNetworkMonitor(networkMonitor);
+        dashboard->connectStorageMonitor(storageMonitor);
+        dashboard->connectSensorMonitor(sensorMonitor);
+        dashboard->connectPressureMonitor(pressureMonitor);
+        mainWindow->topProcessesWidget()->connectProcessMonitor(processMonitor);
+        mainWindow->processTableWidget()->connectProcessMonitor(processMonitor);
 
         // Start all monitoring
         cpuMonitor->start();
         memoryMonitor->start();
         networkMonitor->start();
+        processMonitor->start();
+        storageMonitor->start();
+        sensorMonitor->start();
+        pressureMonitor->start();
+        cgroupMonitor->start();
 
         qDebug() << "Complete integration sucessfull - all monitors active";
     });
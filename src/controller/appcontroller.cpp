@@ -1,5 +1,7 @@
 #include "appcontroller.h"
+#include "datacontroller.h"
 #include "../view/mainwindow.h"
+#include "../view/dashboardwidget.h"
 #include "../core/constants.h"
 #include <QDebug>
 #include <QTimer>
@@ -92,8 +94,7 @@ void AppController::startup()
 
     // Start data monitoring
     if (m_dataController) {
-        // Will implement when DataController is ready
-        qDebug() << "DataController ready for startup";
+        m_dataController->start();
     }
 
     setState(Running);
@@ -119,8 +120,7 @@ void AppController::shutdown()
 
     // Stop data monitoring
     if (m_dataController) {
-        // Will implement when DataController is ready
-        qDebug() << "DataController stopping";
+        m_dataController->stop();
     }
 
     // Hide main window
@@ -245,8 +245,8 @@ void AppController::onInitializationTimer()
 
 void AppController::onDataControllerStateChanged()
 {
-    // Will implement when DataController is ready
-    qDebug() << "DataController state changed";
+    qDebug() << "DataController state changed - running:"
+             << (m_dataController && m_dataController->isRunning());
 }
 
 void AppController::onUIControllerStateChanged()
@@ -260,6 +260,9 @@ bool AppController::createComponents()
     qDebug() << "Creating application components";
 
     try {
+        // Shared sampling scheduler (monitors may already hold a reference)
+        m_dataController = DataController::acquire();
+
         // Create main window
         m_mainWindow = new MainWindow();
         if (!m_mainWindow) {
@@ -289,7 +292,16 @@ bool AppController::connectComponents()
         return false;
     }
 
-    // Basic connection established
+    // Scheduler drives the dashboard clock and reports its state
+    if (m_dataController) {
+        connect(m_dataController, &DataController::runningChanged,
+                this, &AppController::onDataControllerStateChanged);
+
+        if (m_mainWindow && m_mainWindow->dashboardWidget()) {
+            m_mainWindow->dashboardWidget()->connectDataController(m_dataController);
+        }
+    }
+
     // More connections will be added when other controllers are implemented
 
     qDebug() << "All components connected successfully";
@@ -396,6 +408,11 @@ void AppController::cleanupComponents()
         m_mainWindow = nullptr;
     }
 
+    if (m_dataController) {
+        DataController::release();
+        m_dataController = nullptr;
+    }
+
     // Other controllers will be cleaned up when implemented
     m_componentsCreated = false;
     m_componentsConnected = false;
@@ -0,0 +1,302 @@
+#include "datacontroller.h"
+#include "../model/base/basemonitor.h"
+#include "../model/base/samplerthread.h"
+#include "../core/constants.h"
+#include <QDateTime>
+#include <QStandardPaths>
+#include <QThread>
+#include <QDebug>
+
+QMutex DataController::s_mutex;
+DataController *DataController::s_instance = nullptr;
+int DataController::s_refCount = 0;
+
+namespace {
+    int greatestCommonDivisor(int a, int b)
+    {
+        while (b != 0) {
+            int t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+}
+
+DataController *DataController::acquire()
+{
+    QMutexLocker locker(&s_mutex);
+
+    if (!s_instance) {
+        qRegisterMetaType<MetricSample>("MetricSample");
+        s_instance = new DataController;
+    }
+
+    ++s_refCount;
+    return s_instance;
+}
+
+void DataController::release()
+{
+    QMutexLocker locker(&s_mutex);
+
+    if (s_refCount <= 0 || --s_refCount > 0) {
+        return;
+    }
+
+    delete s_instance;
+    s_instance = nullptr;
+}
+
+DataController *DataController::instance()
+{
+    QMutexLocker locker(&s_mutex);
+    return s_instance;
+}
+
+DataController::DataController(QObject *parent)
+    : QObject(parent)
+    , m_worker(new QObject)
+    , m_timer(new QTimer(m_worker))
+    , m_tickInterval(Constants::UPDATE_INTERVAL)
+{
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);    // Keep ticks on the phase boundary
+
+    connect(m_timer, &QTimer::timeout, m_worker, [this]() {
+        onTick();
+    });
+
+    // Timer moves along with its parent
+    m_worker->moveToThread(SamplerThread::acquire());
+
+    // History of earlier runs is mapped back in on the sampler thread, queued
+    // ahead of the first tick, so a slow disk never holds up the GUI
+    const QString dataPath = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation);
+    const QString historyPath = dataPath + "/" + Constants::APP_NAME.toLower().replace(" ", "_") + "/" +
+                                Constants::METRIC_HISTORY_DIR;
+    runOnSampler([this, historyPath]() {
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        if (m_metricStore.openJournal(historyPath)) {
+            m_metricStore.compact(now);
+        }
+        m_lastCheckpoint = now;
+        m_lastCompaction = now;
+    }, false);
+
+    qDebug() << "DataController created";
+}
+
+DataController::~DataController()
+{
+    // Blocks still being filled would be lost otherwise
+    QTimer *timer = m_timer;
+    MetricStore *store = &m_metricStore;
+    runOnSampler([timer, store]() {
+        timer->stop();
+        store->checkpoint();
+    }, true);
+
+    m_worker->deleteLater();
+    SamplerThread::release();
+
+    qDebug() << "DataController destroyed";
+}
+
+void DataController::start()
+{
+    if (m_running) {
+        return;
+    }
+
+    m_running = true;
+    runOnSampler([this]() {
+        scheduleNextTick();
+    }, false);
+
+    qDebug() << "DataController started";
+    emit runningChanged(true);
+}
+
+void DataController::stop()
+{
+    if (!m_running) {
+        return;
+    }
+
+    m_running = false;
+    QTimer *timer = m_timer;
+    runOnSampler([timer]() {
+        timer->stop();
+    }, true);
+
+    qDebug() << "DataController stopped";
+    emit runningChanged(false);
+}
+
+void DataController::addMonitor(BaseMonitor *monitor, int intervalMs)
+{
+    runOnSampler([this, monitor, intervalMs]() {
+        for (const ScheduledMonitor &entry : m_monitors) {
+            if (entry.monitor == monitor) {
+                return;     // Already scheduled
+            }
+        }
+
+        ScheduledMonitor entry;
+        entry.monitor = monitor;
+        entry.interval = intervalMs;
+        m_monitors.append(entry);
+
+        recalculateTick();
+    }, false);
+
+    start();
+}
+
+void DataController::removeMonitor(BaseMonitor *monitor)
+{
+    // Blocking: any batch already touching the monitor finishes first
+    runOnSampler([this, monitor]() {
+        for (int i = 0; i < m_monitors.size(); ++i) {
+            if (m_monitors[i].monitor == monitor) {
+                m_monitors.remove(i);
+                break;
+            }
+        }
+
+        recalculateTick();
+    }, true);
+}
+
+void DataController::setMonitorInterval(BaseMonitor *monitor, int intervalMs)
+{
+    runOnSampler([this, monitor, intervalMs]() {
+        for (ScheduledMonitor &entry : m_monitors) {
+            if (entry.monitor == monitor) {
+                entry.interval = intervalMs;
+            }
+        }
+
+        recalculateTick();
+    }, false);
+}
+
+void DataController::collectNow(BaseMonitor *monitor)
+{
+    runOnSampler([this, monitor]() {
+        if (!monitor->collectOnSampler()) {
+            return;
+        }
+
+        // Out-of-band values (PSI stalls, link changes) belong in the history
+        // too. Stamped before an overdue tick so that tick is not dropped as
+        // older than the series.
+        MetricSample sample;
+        sample.timestamp = QDateTime::currentMSecsSinceEpoch();
+        if (m_timer->isActive()) {
+            sample.timestamp = qMin(sample.timestamp, m_nextTick - 1);
+        }
+        sample.time = SampleTime::now();
+        monitor->appendMetrics(sample);
+        m_metricStore.append(sample.timestamp, sample.values);
+    }, false);
+}
+
+int DataController::tickInterval() const
+{
+    return m_tickInterval.loadAcquire();
+}
+
+QThread *DataController::samplerThread() const
+{
+    return m_worker->thread();
+}
+
+void DataController::runOnSampler(const std::function<void()> &task, bool wait)
+{
+    QThread *sampler = m_worker->thread();
+
+    if (QThread::currentThread() == sampler || !sampler->isRunning()) {
+        task();
+        return;
+    }
+
+    // Blocking calls are queued behind pending work, so returning means the
+    // sampler has finished everything posted before
+    QMetaObject::invokeMethod(m_worker, task,
+                              wait ? Qt::BlockingQueuedConnection : Qt::QueuedConnection);
+}
+
+void DataController::recalculateTick()
+{
+    // The dashboard clock needs a 1 s tick, monitors may need finer ones
+    int tick = Constants::UPDATE_INTERVAL;
+    for (const ScheduledMonitor &entry : m_monitors) {
+        tick = greatestCommonDivisor(tick, entry.interval);
+    }
+
+    if (tick != m_tickInterval.loadAcquire()) {
+        m_tickInterval.storeRelease(tick);
+        qDebug() << "Scheduler tick set to" << tick << "ms";
+
+        // Re-align to the new phase
+        if (m_timer->isActive()) {
+            scheduleNextTick();
+        }
+    }
+}
+
+void DataController::scheduleNextTick()
+{
+    // Phase-align to the next multiple of the tick length so that every
+    // monitor sharing an interval samples at the same instant
+    const qint64 tick = m_tickInterval.loadAcquire();
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    m_nextTick = (now / tick + 1) * tick;
+    m_timer->start(int(m_nextTick - now));
+}
+
+void DataController::onTick()
+{
+    MetricSample sample;
+    sample.timestamp = m_nextTick;
+    sample.tick = m_tickCount++;
+    sample.time = SampleTime::now();
+
+    // Re-arm first; a slow batch skips ticks rather than drifting
+    scheduleNextTick();
+
+    for (const ScheduledMonitor &entry : m_monitors) {
+        if (entry.interval <= 0 || sample.timestamp % entry.interval != 0) {
+            continue;   // Not due on this tick
+        }
+
+        if (entry.monitor->collectOnSampler()) {
+            entry.monitor->appendMetrics(sample);
+        }
+    }
+
+    // Every monitor's headline values feed the retention tiers
+    m_metricStore.append(sample.timestamp, sample.values);
+
+    // Due by elapsed time - ticks that are skipped or not aligned to the
+    // interval must not postpone them. A clock step back restarts the wait.
+    const qint64 now = sample.timestamp;
+    if (now - m_lastCheckpoint >= Constants::METRIC_CHECKPOINT_INTERVAL || now < m_lastCheckpoint) {
+        m_metricStore.checkpoint();
+        m_lastCheckpoint = now;
+    }
+    if (now - m_lastCompaction >= Constants::METRIC_COMPACT_INTERVAL || now < m_lastCompaction) {
+        m_metricStore.compact(now);
+        m_lastCompaction = now;
+    }
+
+    // Queued after every publish() of this batch, so listeners see a
+    // consistent set of monitor snapshots
+    QMetaObject::invokeMethod(this, [this, sample]() {
+        m_lastSample = sample;
+        emit sampleReady(sample);
+    }, Qt::QueuedConnection);
+}
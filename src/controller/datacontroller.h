@@ -0,0 +1,112 @@
+#ifndef DATACONTROLLER_H
+#define DATACONTROLLER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <QMutex>
+#include <QAtomicInt>
+#include <functional>
+#include "../core/metricstore.h"
+#include "../core/sampletime.h"
+
+class BaseMonitor;
+class QThread;
+
+// One scheduler tick: every due monitor collected in the same batch
+struct MetricSample {
+    qint64 timestamp = 0;           // Scheduled tick time (ms since epoch)
+    quint64 tick = 0;               // Tick counter since start
+    SampleTime time;                // Monotonic/boottime stamp when the batch ran
+    QHash<QString, double> values;  // "cpu.usage", "memory.usage", ...
+};
+
+Q_DECLARE_METATYPE(MetricSample)
+
+// Central sampling scheduler. Owns the only sampling timer: it wakes once per
+// tick on the sampler thread, phase-aligned to multiples of the tick length,
+// collects every monitor whose interval divides the tick time and emits one
+// timestamped MetricSample. Replaces the per-monitor QTimers.
+class DataController : public QObject
+{
+    Q_OBJECT
+public:
+    // Reference counted like SamplerThread - monitors and AppController share it
+    static DataController *acquire();
+    static void release();
+    static DataController *instance();
+
+    // Scheduling (start also happens implicitly on the first monitor)
+    void start();
+    void stop();
+    bool isRunning() const {
+        return m_running;
+    }
+
+    // Monitor registration - removeMonitor() blocks until the monitor is idle
+    void addMonitor(BaseMonitor *monitor, int intervalMs);
+    void removeMonitor(BaseMonitor *monitor);
+    void setMonitorInterval(BaseMonitor *monitor, int intervalMs);
+
+    // Queue one out-of-band collection for a monitor (manual refresh, event);
+    // its metrics go into the MetricStore like a tick's
+    void collectNow(BaseMonitor *monitor);
+
+    // Run a task on the sampler thread, optionally blocking until it is done
+    void runOnSampler(const std::function<void()> &task, bool wait);
+    QThread *samplerThread() const;
+
+    // Current tick length (gcd of all intervals)
+    int tickInterval() const;
+
+    // Last batch delivered to the GUI thread
+    MetricSample lastSample() const {
+        return m_lastSample;
+    }
+
+    // Tiered history of every MetricSample value, filled on the sampler thread
+    const MetricStore &metricStore() const {
+        return m_metricStore;
+    }
+
+signals:
+    // Emitted on the GUI thread after all monitors of the batch published
+    void sampleReady(const MetricSample &sample);
+    void runningChanged(bool running);
+
+private:
+    explicit DataController(QObject *parent = nullptr);
+    ~DataController();
+
+    struct ScheduledMonitor {
+        BaseMonitor *monitor = nullptr;
+        int interval = 0;
+    };
+
+    // Sampler-thread side
+    void recalculateTick();
+    void scheduleNextTick();
+    void onTick();
+
+    QObject *m_worker;                      // Sampler-thread context
+    QTimer *m_timer;                        // Single-shot, re-armed every tick
+    QVector<ScheduledMonitor> m_monitors;   // Sampler thread only
+    QAtomicInt m_tickInterval;              // Read from the GUI thread
+    qint64 m_nextTick = 0;
+    quint64 m_tickCount = 0;
+    qint64 m_lastCheckpoint = 0;            // Journal maintenance, wall-clock ms
+    qint64 m_lastCompaction = 0;
+    MetricStore m_metricStore;              // Locked internally, queried from the GUI
+
+    // GUI-thread side
+    bool m_running = false;
+    MetricSample m_lastSample;
+
+    static QMutex s_mutex;
+    static DataController *s_instance;
+    static int s_refCount;
+};
+
+#endif // DATACONTROLLER_H
@@ -0,0 +1,22 @@
+#ifndef BYTEVIEW_H
+#define BYTEVIEW_H
+
+// Non-owning view over a run of raw bytes (e.g. a ProcFileReader buffer)
+struct ByteView {
+    const char *data = nullptr;
+    int size = 0;
+
+    bool isEmpty() const {
+        return size <= 0;
+    }
+
+    const char *begin() const {
+        return data;
+    }
+
+    const char *end() const {
+        return data + size;
+    }
+};
+
+#endif // BYTEVIEW_H
@@ -0,0 +1,203 @@
+#include "cgroupparser.h"
+#include <cstring>
+
+namespace {
+    inline quint64 parseNumber(const char *&p, const char *end)
+    {
+        while (p < end && *p == ' ') {
+            ++p;
+        }
+
+        quint64 result = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            result = result * 10 + quint64(*p - '0');
+            ++p;
+        }
+
+        return result;
+    }
+
+    inline bool keyIs(const char *key, int length, const char *name)
+    {
+        return int(std::strlen(name)) == length && std::memcmp(key, name, length) == 0;
+    }
+
+    // Calls field(key, keyLength, value) for every "key value" line
+    template <typename Field>
+    int forEachField(const ByteView &bytes, Field field)
+    {
+        const char *p = bytes.begin();
+        const char *end = bytes.end();
+        int count = 0;
+
+        while (p < end) {
+            const char *lineEnd = static_cast<const char *>(std::memchr(p, '\n', end - p));
+            if (!lineEnd) {
+                lineEnd = end;
+            }
+
+            const char *key = p;
+            while (p < lineEnd && *p != ' ') {
+                ++p;
+            }
+            const int keyLength = int(p - key);
+
+            if (keyLength > 0 && p < lineEnd) {
+                field(key, keyLength, parseNumber(p, lineEnd));
+                ++count;
+            }
+
+            p = lineEnd + 1;
+        }
+
+        return count;
+    }
+}
+
+bool CgroupParser::parseCpuStat(const ByteView &bytes, CgroupCpuStat &out)
+{
+    out = CgroupCpuStat();
+    return forEachField(bytes, [&out](const char *key, int length, quint64 value) {
+        if (keyIs(key, length, "usage_usec")) {
+            out.usageUsec = value;
+        }
+        else if (keyIs(key, length, "user_usec")) {
+            out.userUsec = value;
+        }
+        else if (keyIs(key, length, "system_usec")) {
+            out.systemUsec = value;
+        }
+        else if (keyIs(key, length, "nr_periods")) {
+            out.nrPeriods = value;
+        }
+        else if (keyIs(key, length, "nr_throttled")) {
+            out.nrThrottled = value;
+        }
+        else if (keyIs(key, length, "throttled_usec")) {
+            out.throttledUsec = value;
+        }
+    }) > 0;
+}
+
+bool CgroupParser::parseCpuMax(const ByteView &bytes, CgroupCpuMax &out)
+{
+    const char *p = bytes.begin();
+    const char *end = bytes.end();
+    if (p >= end) {
+        return false;
+    }
+
+    if (end - p >= 3 && std::memcmp(p, "max", 3) == 0) {
+        out.quotaUsec = -1;
+        p += 3;
+    }
+    else {
+        out.quotaUsec = qint64(parseNumber(p, end));
+    }
+
+    const quint64 period = parseNumber(p, end);
+    out.periodUsec = period > 0 ? qint64(period) : 100000;
+    return true;
+}
+
+bool CgroupParser::parseMemoryStat(const ByteView &bytes, CgroupMemoryStat &out)
+{
+    out = CgroupMemoryStat();
+    return forEachField(bytes, [&out](const char *key, int length, quint64 value) {
+        if (keyIs(key, length, "anon")) {
+            out.anon = value;
+        }
+        else if (keyIs(key, length, "file")) {
+            out.file = value;
+        }
+        else if (keyIs(key, length, "kernel")) {
+            out.kernel = value;
+        }
+        else if (keyIs(key, length, "shmem")) {
+            out.shmem = value;
+        }
+        else if (keyIs(key, length, "file_dirty")) {
+            out.fileDirty = value;
+        }
+        else if (keyIs(key, length, "file_writeback")) {
+            out.fileWriteback = value;
+        }
+        else if (keyIs(key, length, "pgfault")) {
+            out.pgfault = value;
+        }
+        else if (keyIs(key, length, "pgmajfault")) {
+            out.pgmajfault = value;
+        }
+    }) > 0;
+}
+
+bool CgroupParser::parseIoStat(const ByteView &bytes, CgroupIoStat &out)
+{
+    out = CgroupIoStat();
+
+    // "8:0 rbytes=1 wbytes=2 rios=3 wios=4 dbytes=0 dios=0" per device
+    const char *p = bytes.begin();
+    const char *end = bytes.end();
+
+    while (p < end) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+
+        while (p < lineEnd) {
+            const char *key = p;
+            while (p < lineEnd && *p != '=' && *p != ' ') {
+                ++p;
+            }
+            const int length = int(p - key);
+
+            if (p < lineEnd && *p == '=') {
+                ++p;
+                const quint64 value = parseNumber(p, lineEnd);
+                if (keyIs(key, length, "rbytes")) {
+                    out.readBytes += value;
+                }
+                else if (keyIs(key, length, "wbytes")) {
+                    out.writeBytes += value;
+                }
+                else if (keyIs(key, length, "rios")) {
+                    out.readIos += value;
+                }
+                else if (keyIs(key, length, "wios")) {
+                    out.writeIos += value;
+                }
+            }
+
+            while (p < lineEnd && *p != ' ') {
+                ++p;
+            }
+            while (p < lineEnd && *p == ' ') {
+                ++p;
+            }
+        }
+
+        p = lineEnd + 1;
+    }
+
+    return true;
+}
+
+qint64 CgroupParser::parseValue(const ByteView &bytes, bool *ok)
+{
+    const char *p = bytes.begin();
+    const char *end = bytes.end();
+
+    const bool valid = p < end && ((*p >= '0' && *p <= '9') || *p == 'm');
+    if (ok) {
+        *ok = valid;
+    }
+    if (!valid) {
+        return 0;
+    }
+
+    if (end - p >= 3 && std::memcmp(p, "max", 3) == 0) {
+        return -1;
+    }
+    return qint64(parseNumber(p, end));
+}
@@ -0,0 +1,56 @@
+#ifndef CGROUPPARSER_H
+#define CGROUPPARSER_H
+
+#include <QtGlobal>
+#include "byteview.h"
+
+// cpu.stat (microseconds, cumulative)
+struct CgroupCpuStat {
+    quint64 usageUsec = 0;
+    quint64 userUsec = 0;
+    quint64 systemUsec = 0;
+    quint64 nrPeriods = 0;
+    quint64 nrThrottled = 0;
+    quint64 throttledUsec = 0;
+};
+
+// cpu.max - "max 100000" or "50000 100000"
+struct CgroupCpuMax {
+    qint64 quotaUsec = -1;          // -1 = unlimited
+    qint64 periodUsec = 100000;
+};
+
+// Selected memory.stat fields (bytes, except the fault counters)
+struct CgroupMemoryStat {
+    quint64 anon = 0;
+    quint64 file = 0;
+    quint64 kernel = 0;
+    quint64 shmem = 0;
+    quint64 fileDirty = 0;
+    quint64 fileWriteback = 0;
+    quint64 pgfault = 0;
+    quint64 pgmajfault = 0;
+};
+
+// io.stat summed over every device line
+struct CgroupIoStat {
+    quint64 readBytes = 0;
+    quint64 writeBytes = 0;
+    quint64 readIos = 0;
+    quint64 writeIos = 0;
+};
+
+// Allocation-free parsers for the cgroup v2 interface files
+class CgroupParser
+{
+public:
+    static bool parseCpuStat(const ByteView &bytes, CgroupCpuStat &out);
+    static bool parseCpuMax(const ByteView &bytes, CgroupCpuMax &out);
+    static bool parseMemoryStat(const ByteView &bytes, CgroupMemoryStat &out);
+    static bool parseIoStat(const ByteView &bytes, CgroupIoStat &out);
+
+    // Single value files (memory.current, memory.max): "max" gives -1
+    static qint64 parseValue(const ByteView &bytes, bool *ok = nullptr);
+};
+
+#endif // CGROUPPARSER_H
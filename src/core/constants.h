@@ -15,7 +15,12 @@ namespace Constants
     const int FAST_UPDATE_INTERVAL = 500;          // High-frequency updates
     const int SLOW_UPDATE_INTERVAL = 5000;         // Low-frequency updates
     const int NETWORK_UPDATE_INTERVAL = 2000;      // Network speed calculation
+    const int NETWORK_NAME_REFRESH_INTERVAL = 30000; // Link renames without link events
     const int STORAGE_UPDATE_INTERVAL = 5000;      // Storage monitoring
+    const int PROCESS_UPDATE_INTERVAL = 1000;      // Per-process /proc scan
+    const int SENSOR_UPDATE_INTERVAL = 2000;       // Thermal/hwmon sensors
+    const int PRESSURE_UPDATE_INTERVAL = 2000;     // PSI averages (stalls are event-driven)
+    const int CGROUP_UPDATE_INTERVAL = 2000;       // cgroup v2 hierarchy
     const int ALERT_CHECK_INTERVAL = 3000;         // Alert threshold checking
     const int ALERT_CLEANUP_INTERVAL = 300000;     // Alert cleanup (5 minutes)
 
@@ -26,6 +31,36 @@ namespace Constants
     const double RAM_CRITICAL_THRESHOLD = 95.0;
     const double TEMP_WARNING_THRESHOLD = 70.0;    // Celsius
     const double TEMP_CRITICAL_THRESHOLD = 80.0;   // Celsius
+    const double PSI_WARNING_THRESHOLD = 10.0;     // "some" avg10, percent stalled
+    const double PSI_CRITICAL_THRESHOLD = 25.0;
+
+    // PSI triggers: notify when tasks stall this long within one window
+    const qint64 PSI_TRIGGER_STALL_US = 100000;        // 100 ms
+    const qint64 PSI_TRIGGER_WINDOW_US = 1000000;      // 1 s (needs CAP_SYS_RESOURCE)
+    const qint64 PSI_UNPRIVILEGED_WINDOW_US = 2000000; // Unprivileged minimum
+
+    // Filesystem usage probing (statvfs can hang on dead network mounts)
+    const int STORAGE_PROBE_THREADS = 4;
+    const int STORAGE_PROBE_MAX_THREADS = 16;      // Including replacements for hung ones
+    const int STORAGE_PROBE_DEADLINE = 500;        // Probe run time before a mount is stale (ms)
+    const int STORAGE_PROBE_MAX_BACKOFF = 300000;  // Quarantine cap (5 minutes)
+
+    // Metric store retention tiers - every series preallocates all three
+    const qint64 METRIC_RAW_RETENTION = 600000;            // Every sample for 10 minutes
+    const qint64 METRIC_MEDIUM_RESOLUTION = 10000;         // 10 s min/avg/max...
+    const qint64 METRIC_MEDIUM_RETENTION = 86400000;       // ...for 24 hours
+    const qint64 METRIC_LONG_RESOLUTION = 300000;          // 5 min min/avg/max...
+    const qint64 METRIC_LONG_RETENTION = 2592000000LL;     // ...for 30 days
+    const int METRIC_STORE_MAX_SERIES = 64;                // Hard cap on memory
+    const int METRIC_BLOCK_POINTS = 120;                   // Points per compressed block
+    const qint64 METRIC_SEGMENT_SIZE = 4 * 1024 * 1024;    // On-disk history segment
+    const int METRIC_CHECKPOINT_INTERVAL = 300000;         // Save unsealed blocks (ms), also at shutdown
+    const int METRIC_COMPACT_INTERVAL = 3600000;           // Drop expired segments (ms)
+
+    // Sliding windows kept for every series (min/max/mean/stddev/rate)
+    const qint64 METRIC_WINDOW_SHORT = 10000;              // 10 s
+    const qint64 METRIC_WINDOW_MEDIUM = 60000;             // 1 min
+    const qint64 METRIC_WINDOW_LONG = 300000;              // 5 min
 
     // UI Dimensions
     const int WINDOW_WIDTH = 800;
@@ -39,9 +74,23 @@ namespace Constants
     const QString PROC_MEMINFO = "/proc/meminfo";
     const QString PROC_CPUINFO = "/proc/cpuinfo";
     const QString PROC_NET_DEV = "/proc/net/dev";
-    const QString PROC_MOUNTS = "/proc/mounts";
+    const QString PROC_MOUNTS = "/proc/self/mounts";
+    const QString PROC_DISKSTATS = "/proc/diskstats";
     const QString PROC_VERSION = "/proc/version";
     const QString PROC_UPTIME = "/proc/uptime";
+    const QString PROC_DIR = "/proc";
+    const QString PROC_PRESSURE_DIR = "/proc/pressure";
+    const QString PROC_SELF_CGROUP = "/proc/self/cgroup";
+
+    // sysfs (enumerated once, then read through open descriptors)
+    const QString SYS_THERMAL_DIR = "/sys/class/thermal";
+    const QString SYS_HWMON_DIR = "/sys/class/hwmon";
+    const QString SYS_CPU_DIR = "/sys/devices/system/cpu";
+    const QString SYS_CGROUP_DIR = "/sys/fs/cgroup";
+    const QString SYS_BLOCK_DIR = "/sys/class/block";
+
+    // Metric history segments, below the app's data directory
+    const QString METRIC_HISTORY_DIR = "history";
 
     // Colors (Hex values)
     // Color Schemes (Hex values)
@@ -84,7 +133,7 @@ namespace Constants
     };
 
     // Default Values
-    const int DEFAULT_HISTORY_SIZE = 60;           // Keep 60 data points
+    const int DEFAULT_HISTORY_SIZE = 3600;         // One hour at the 1 s interval
     const int MAX_ALERTS_HISTORY = 100;            // Maximum alerts to store
     const double EPSILON = 0.001;                  // For floating point comp
 
@@ -0,0 +1,39 @@
+#ifndef CPUUSAGEKERNEL_H
+#define CPUUSAGEKERNEL_H
+
+#include <QtGlobal>
+
+namespace CpuUsageKernel
+{
+    // Per-core usage from structure-of-arrays jiffy counters in one pass.
+    // Writes usage[i] in percent (0-100) and rolls current into previous.
+    // Seed previous with current on the first sample.
+    // The loop body is branch-free so the compiler can vectorise it.
+    inline void computeUsage(const quint64 *total, const quint64 *idle,
+                             quint64 *prevTotal, quint64 *prevIdle,
+                             double *usage, int count)
+    {
+        for (int i = 0; i < count; ++i) {
+            // Per-interval deltas fit easily in 32 bits (2^31 jiffies is
+            // months at 100 Hz), and int32 -> double converts in SIMD on
+            // every x86-64 level, unlike int64 -> double before AVX-512
+            const double totalDiff = double(qint32(total[i] - prevTotal[i]));
+            const double idleDiff = double(qint32(idle[i] - prevIdle[i]));
+
+            // Divide by at least one jiffy instead of branching on zero;
+            // an idle interval yields 0 and the clamp covers counter glitches
+            const double divisor = totalDiff > 1.0 ? totalDiff : 1.0;
+            double value = (totalDiff - idleDiff) * 100.0 / divisor;
+
+            // Clamp to valid range
+            value = value > 0.0 ? value : 0.0;
+            value = value < 100.0 ? value : 100.0;
+
+            usage[i] = value;
+            prevTotal[i] = total[i];
+            prevIdle[i] = idle[i];
+        }
+    }
+}
+
+#endif // CPUUSAGEKERNEL_H
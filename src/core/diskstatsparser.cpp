@@ -0,0 +1,88 @@
+#include "diskstatsparser.h"
+#include <cstring>
+
+namespace {
+    inline quint64 parseNumber(const char *&p, const char *end)
+    {
+        while (p < end && *p == ' ') {
+            ++p;
+        }
+
+        quint64 result = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            result = result * 10 + quint64(*p - '0');
+            ++p;
+        }
+
+        return result;
+    }
+
+    inline bool isSkippedDevice(const char *name, int length)
+    {
+        return (length > 4 && std::memcmp(name, "loop", 4) == 0)
+               || (length > 3 && std::memcmp(name, "ram", 3) == 0);
+    }
+}
+
+int DiskStatsParser::parse(const ByteView &bytes, QVector<DiskCounters> &out)
+{
+    const char *p = bytes.begin();
+    const char *end = bytes.end();
+
+    // Format: "   8       0 sda reads merged sectors ms writes merged sectors ms
+    //          in_flight io_ms weighted_ms [discard and flush fields]"
+    int index = 0;
+    while (p < end) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+
+        const char *q = p;
+        parseNumber(q, lineEnd);    // major
+        parseNumber(q, lineEnd);    // minor
+
+        while (q < lineEnd && *q == ' ') {
+            ++q;
+        }
+        const char *name = q;
+        while (q < lineEnd && *q != ' ') {
+            ++q;
+        }
+        const int nameLength = int(q - name);
+
+        if (nameLength > 0 && !isSkippedDevice(name, nameLength)) {
+            if (index >= out.size()) {
+                out.resize(index + 1);
+            }
+
+            DiskCounters &counters = out[index++];
+            int length = qMin(nameLength, int(sizeof(counters.name)) - 1);
+            std::memcpy(counters.name, name, length);
+            counters.name[length] = '\0';
+
+            quint64 fields[11];
+            for (quint64 &field : fields) {
+                field = parseNumber(q, lineEnd);
+            }
+
+            counters.readsCompleted = fields[0];
+            counters.sectorsRead = fields[2];
+            counters.readTimeMs = fields[3];
+            counters.writesCompleted = fields[4];
+            counters.sectorsWritten = fields[6];
+            counters.writeTimeMs = fields[7];
+            counters.inFlight = fields[8];
+            counters.ioTimeMs = fields[9];
+            counters.weightedIoTimeMs = fields[10];
+        }
+
+        p = lineEnd + 1;
+    }
+
+    if (out.size() != index) {
+        out.resize(index);
+    }
+
+    return index;
+}
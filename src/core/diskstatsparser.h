@@ -0,0 +1,31 @@
+#ifndef DISKSTATSPARSER_H
+#define DISKSTATSPARSER_H
+
+#include <QtGlobal>
+#include <QVector>
+#include "byteview.h"
+
+// Raw counters of one /proc/diskstats line (sectors are 512 bytes)
+struct DiskCounters {
+    char name[32] = {};
+    quint64 readsCompleted = 0;
+    quint64 sectorsRead = 0;
+    quint64 readTimeMs = 0;
+    quint64 writesCompleted = 0;
+    quint64 sectorsWritten = 0;
+    quint64 writeTimeMs = 0;
+    quint64 inFlight = 0;           // Gauge, not a counter
+    quint64 ioTimeMs = 0;           // Time the device had I/O queued
+    quint64 weightedIoTimeMs = 0;
+};
+
+// Single-pass /proc/diskstats parser. Fills one flat entry per device in
+// file order; the vector only reallocates when the device count changes.
+class DiskStatsParser
+{
+public:
+    // Returns the number of devices parsed. Loop and ram disks are skipped.
+    static int parse(const ByteView &bytes, QVector<DiskCounters> &out);
+};
+
+#endif // DISKSTATSPARSER_H
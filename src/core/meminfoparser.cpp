@@ -0,0 +1,200 @@
+#include "meminfoparser.h"
+#include <cstring>
+
+namespace {
+    // Same order as MeminfoData::Field
+    constexpr const char *FIELD_NAMES[MeminfoData::FieldCount] = {
+        "MemTotal",
+        "MemFree",
+        "MemAvailable",
+        "Buffers",
+        "Cached",
+        "SwapCached",
+        "Active",
+        "Inactive",
+        "Active(anon)",
+        "Inactive(anon)",
+        "Active(file)",
+        "Inactive(file)",
+        "Unevictable",
+        "Mlocked",
+        "HighTotal",
+        "HighFree",
+        "LowTotal",
+        "LowFree",
+        "MmapCopy",
+        "SwapTotal",
+        "SwapFree",
+        "Zswap",
+        "Zswapped",
+        "Dirty",
+        "Writeback",
+        "AnonPages",
+        "Mapped",
+        "Shmem",
+        "KReclaimable",
+        "Slab",
+        "SReclaimable",
+        "SUnreclaim",
+        "KernelStack",
+        "ShadowCallStack",
+        "PageTables",
+        "SecPageTables",
+        "NFS_Unstable",
+        "Bounce",
+        "WritebackTmp",
+        "CommitLimit",
+        "Committed_AS",
+        "VmallocTotal",
+        "VmallocUsed",
+        "VmallocChunk",
+        "Percpu",
+        "HardwareCorrupted",
+        "AnonHugePages",
+        "ShmemHugePages",
+        "ShmemPmdMapped",
+        "FileHugePages",
+        "FilePmdMapped",
+        "CmaTotal",
+        "CmaFree",
+        "Unaccepted",
+        "Balloon",
+        "HugePages_Total",
+        "HugePages_Free",
+        "HugePages_Rsvd",
+        "HugePages_Surp",
+        "Hugepagesize",
+        "Hugetlb",
+        "DirectMap4k",
+        "DirectMap4M",
+        "DirectMap2M",
+        "DirectMap1G"
+    };
+
+    // FNV-1a with a seed searched offline so that every key above lands in
+    // its own slot. Adding a key may need a new seed - the static_assert
+    // below catches collisions at build time.
+    constexpr quint32 HASH_SEED = 2166143566u;
+    constexpr int SLOT_COUNT = 256;
+    constexpr quint8 NO_FIELD = 0xFF;
+
+    constexpr int hashSlot(const char *key, int length)
+    {
+        quint32 hash = HASH_SEED;
+        for (int i = 0; i < length; ++i) {
+            hash ^= quint8(key[i]);
+            hash *= 16777619u;
+        }
+        return int(((hash >> 16) ^ hash) & (SLOT_COUNT - 1));
+    }
+
+    constexpr int keyLength(const char *key)
+    {
+        int length = 0;
+        while (key[length]) {
+            ++length;
+        }
+        return length;
+    }
+
+    struct SlotTable {
+        quint8 fields[SLOT_COUNT] = {};
+        bool collisionFree = true;
+    };
+
+    constexpr SlotTable buildSlotTable()
+    {
+        SlotTable table;
+        for (int i = 0; i < SLOT_COUNT; ++i) {
+            table.fields[i] = NO_FIELD;
+        }
+
+        for (int field = 0; field < MeminfoData::FieldCount; ++field) {
+            int slot = hashSlot(FIELD_NAMES[field], keyLength(FIELD_NAMES[field]));
+            if (table.fields[slot] != NO_FIELD) {
+                table.collisionFree = false;
+            }
+            table.fields[slot] = quint8(field);
+        }
+
+        return table;
+    }
+
+    constexpr SlotTable SLOTS = buildSlotTable();
+    static_assert(SLOTS.collisionFree, "meminfo key hash has collisions - pick a new HASH_SEED");
+    static_assert(MeminfoData::FieldCount < NO_FIELD, "meminfo field index must fit in a slot");
+}
+
+const char *MeminfoData::fieldName(Field field)
+{
+    return FIELD_NAMES[field];
+}
+
+int MeminfoParser::fieldIndex(const char *key, int length)
+{
+    int field = SLOTS.fields[hashSlot(key, length)];
+    if (field == NO_FIELD) {
+        return -1;
+    }
+
+    // Unknown keys can still hash into a used slot - confirm the bytes
+    const char *name = FIELD_NAMES[field];
+    if (std::strncmp(name, key, length) != 0 || name[length] != '\0') {
+        return -1;
+    }
+
+    return field;
+}
+
+bool MeminfoParser::parse(const ByteView &bytes, MeminfoData &out)
+{
+    const char *p = bytes.begin();
+    const char *end = bytes.end();
+
+    std::memset(out.present, 0, sizeof(out.present));
+
+    // Format: "MemTotal:        1024000 kB" or "HugePages_Total:       0"
+    while (p < end) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+
+        const char *colon = static_cast<const char *>(std::memchr(p, ':', lineEnd - p));
+        int field = colon ? fieldIndex(p, int(colon - p)) : -1;
+
+        if (field >= 0) {
+            const char *q = colon + 1;
+            while (q < lineEnd && *q == ' ') {
+                ++q;
+            }
+
+            const char *digits = q;
+            qint64 value = 0;
+            while (q < lineEnd && *q >= '0' && *q <= '9') {
+                value = value * 10 + (*q - '0');
+                ++q;
+            }
+
+            if (q > digits) {
+                // Only the kB lines carry a unit, the rest are counts
+                if (q + 3 <= lineEnd && std::memcmp(q, " kB", 3) == 0) {
+                    value *= 1024;
+                }
+                out.values[field] = value;
+                out.present[field] = true;
+            }
+        }
+
+        p = lineEnd + 1;
+    }
+
+    // Fields missing from this read (e.g. a module went away) read as 0
+    for (int i = 0; i < MeminfoData::FieldCount; ++i) {
+        if (!out.present[i]) {
+            out.values[i] = 0;
+        }
+    }
+
+    return out.present[MeminfoData::MemTotal];
+}
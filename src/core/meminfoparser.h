@@ -0,0 +1,107 @@
+#ifndef MEMINFOPARSER_H
+#define MEMINFOPARSER_H
+
+#include <QtGlobal>
+#include "byteview.h"
+
+// Every field /proc/meminfo may report. Sizes are stored in bytes, the
+// HugePages_* lines are page counts. Fields the kernel does not report
+// (config dependent) stay 0 and are flagged as not present.
+struct MeminfoData {
+    enum Field {
+        MemTotal,
+        MemFree,
+        MemAvailable,
+        Buffers,
+        Cached,
+        SwapCached,
+        Active,
+        Inactive,
+        ActiveAnon,
+        InactiveAnon,
+        ActiveFile,
+        InactiveFile,
+        Unevictable,
+        Mlocked,
+        HighTotal,
+        HighFree,
+        LowTotal,
+        LowFree,
+        MmapCopy,
+        SwapTotal,
+        SwapFree,
+        Zswap,
+        Zswapped,
+        Dirty,
+        Writeback,
+        AnonPages,
+        Mapped,
+        Shmem,
+        KReclaimable,
+        Slab,
+        SReclaimable,
+        SUnreclaim,
+        KernelStack,
+        ShadowCallStack,
+        PageTables,
+        SecPageTables,
+        NFSUnstable,
+        Bounce,
+        WritebackTmp,
+        CommitLimit,
+        CommittedAS,
+        VmallocTotal,
+        VmallocUsed,
+        VmallocChunk,
+        Percpu,
+        HardwareCorrupted,
+        AnonHugePages,
+        ShmemHugePages,
+        ShmemPmdMapped,
+        FileHugePages,
+        FilePmdMapped,
+        CmaTotal,
+        CmaFree,
+        Unaccepted,
+        Balloon,
+        HugePagesTotal,
+        HugePagesFree,
+        HugePagesRsvd,
+        HugePagesSurp,
+        Hugepagesize,
+        Hugetlb,
+        DirectMap4k,
+        DirectMap4M,
+        DirectMap2M,
+        DirectMap1G,
+        FieldCount
+    };
+
+    qint64 values[FieldCount] = {};
+    bool present[FieldCount] = {};
+
+    qint64 value(Field field) const {
+        return values[field];
+    }
+
+    bool has(Field field) const {
+        return present[field];
+    }
+
+    // Key as it appears in /proc/meminfo, e.g. "Active(anon)"
+    static const char *fieldName(Field field);
+};
+
+// Single-pass, allocation-free /proc/meminfo parser. Keys are dispatched
+// through a perfect hash built at compile time over the raw key bytes.
+class MeminfoParser
+{
+public:
+    // Returns false if MemTotal is missing
+    static bool parse(const ByteView &bytes, MeminfoData &out);
+
+    // Field index of a raw key (without the colon), -1 if unknown
+    static int fieldIndex(const char *key, int length);
+};
+
+#endif // MEMINFOPARSER_H
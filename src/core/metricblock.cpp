@@ -0,0 +1,271 @@
+#include "metricblock.h"
+#include <QtAlgorithms>
+#include <cstring>
+
+namespace {
+    inline quint32 floatBits(float value)
+    {
+        quint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    inline float bitsFloat(quint32 bits)
+    {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    // Delta-of-delta buckets: '0', then '10', '110', '1110' + n-bit two's
+    // complement, '1111' + 64 bits for anything larger
+    const int SIGNED_WIDTHS[] = { 7, 9, 12 };
+}
+
+void MetricBlockEncoder::clear()
+{
+    // Keeps the buffer's capacity for the next block
+    m_data.resize(0);
+    m_bitCount = 0;
+    m_count = 0;
+    m_firstTimestamp = 0;
+    m_timestamp = 0;
+    m_delta = 0;
+    m_pointCount = 0;
+    m_min = FloatColumn();
+    m_max = FloatColumn();
+    m_mean = FloatColumn();
+}
+
+MetricBlock MetricBlockEncoder::seal() const
+{
+    MetricBlock block;
+    block.data = QByteArray(m_data.constData(), m_data.size());
+    block.count = m_count;
+    block.firstTimestamp = m_firstTimestamp;
+    block.lastTimestamp = m_timestamp;
+    return block;
+}
+
+void MetricBlockEncoder::writeBits(quint64 value, int count)
+{
+    // Most significant bit first
+    while (count > 0) {
+        const int byteIndex = m_bitCount / 8;
+        if (byteIndex == m_data.size()) {
+            m_data.append(char(0));
+        }
+
+        const int free = 8 - m_bitCount % 8;
+        const int n = qMin(free, count);
+        const quint64 chunk = (value >> (count - n)) & ((1u << n) - 1);
+        m_data.data()[byteIndex] |= char(chunk << (free - n));
+
+        m_bitCount += n;
+        count -= n;
+    }
+}
+
+void MetricBlockEncoder::writeSigned(qint64 value)
+{
+    if (value == 0) {
+        writeBits(0, 1);
+        return;
+    }
+
+    int prefix = 1;
+    for (int width : SIGNED_WIDTHS) {
+        // Prefix '1'*prefix + '0'
+        if (value >= -(qint64(1) << (width - 1)) && value < (qint64(1) << (width - 1))) {
+            writeBits((quint64(1) << (prefix + 1)) - 2, prefix + 1);
+            writeBits(quint64(value), width);
+            return;
+        }
+        ++prefix;
+    }
+
+    writeBits(0xF, 4);
+    writeBits(quint64(value), 64);
+}
+
+void MetricBlockEncoder::writeFloat(FloatColumn &column, quint32 bits)
+{
+    const quint32 x = bits ^ column.previous;
+    column.previous = bits;
+
+    if (x == 0) {
+        writeBits(0, 1);
+        return;
+    }
+
+    const int leading = int(qCountLeadingZeroBits(x));
+    const int trailing = int(qCountTrailingZeroBits(x));
+
+    if (column.leading >= 0 && leading >= column.leading && trailing >= column.trailing) {
+        // Fits the previous window - just the meaningful bits
+        writeBits(0x2, 2);
+        writeBits(x >> column.trailing, 32 - column.leading - column.trailing);
+        return;
+    }
+
+    const int length = 32 - leading - trailing;
+    writeBits(0x3, 2);
+    writeBits(quint64(leading), 5);
+    writeBits(quint64(length - 1), 5);
+    writeBits(x >> trailing, length);
+
+    column.leading = leading;
+    column.trailing = trailing;
+}
+
+void MetricBlockEncoder::append(const MetricBucket &point)
+{
+    const quint32 min = floatBits(point.min);
+    const quint32 max = floatBits(point.max);
+    const quint32 mean = floatBits(point.mean);
+
+    if (m_count == 0) {
+        // Block header: first point stored in full
+        m_firstTimestamp = point.timestamp;
+        writeBits(quint64(point.timestamp), 64);
+        writeBits(point.count, 32);
+        writeBits(min, 32);
+        m_min.previous = min;
+    } else {
+        const qint64 delta = point.timestamp - m_timestamp;
+        writeSigned(delta - m_delta);
+        writeSigned(qint64(point.count) - qint64(m_pointCount));
+        writeFloat(m_min, min);
+        m_delta = delta;
+    }
+
+    m_timestamp = point.timestamp;
+    m_pointCount = point.count;
+
+    // max and mean: '0' = same as min, else '1' + XOR against their own column
+    FloatColumn *columns[] = { &m_max, &m_mean };
+    const quint32 values[] = { max, mean };
+    for (int i = 0; i < 2; ++i) {
+        if (values[i] == min) {
+            writeBits(0, 1);
+            columns[i]->previous = min;
+        } else if (m_count == 0) {
+            writeBits(1, 1);
+            writeBits(values[i], 32);
+            columns[i]->previous = values[i];
+        } else {
+            writeBits(1, 1);
+            writeFloat(*columns[i], values[i]);
+        }
+    }
+
+    ++m_count;
+}
+
+MetricBlockDecoder::MetricBlockDecoder(const QByteArray &data, int count)
+    : m_data(reinterpret_cast<const uchar *>(data.constData()))
+    , m_size(data.size())
+    , m_remaining(count)
+{
+}
+
+quint64 MetricBlockDecoder::readBits(int count)
+{
+    quint64 value = 0;
+    while (count > 0) {
+        const int byteIndex = m_bitPosition / 8;
+        if (byteIndex >= m_size) {
+            // Truncated block - pad with zeros (a shift by 64 is undefined)
+            return count < 64 ? value << count : 0;
+        }
+
+        const int available = 8 - m_bitPosition % 8;
+        const int n = qMin(available, count);
+        const quint64 chunk = (m_data[byteIndex] >> (available - n)) & ((1u << n) - 1);
+        value = (value << n) | chunk;
+
+        m_bitPosition += n;
+        count -= n;
+    }
+    return value;
+}
+
+qint64 MetricBlockDecoder::readSigned()
+{
+    if (readBits(1) == 0) {
+        return 0;
+    }
+
+    for (int width : SIGNED_WIDTHS) {
+        if (readBits(1) == 0) {
+            const quint64 value = readBits(width);
+            // Sign-extend
+            const quint64 sign = quint64(1) << (width - 1);
+            return qint64((value ^ sign) - sign);
+        }
+    }
+
+    return qint64(readBits(64));
+}
+
+quint32 MetricBlockDecoder::readFloat(FloatColumn &column)
+{
+    if (readBits(1) == 0) {
+        return column.previous;
+    }
+
+    quint32 x;
+    if (readBits(1) == 0) {
+        x = quint32(readBits(32 - column.leading - column.trailing)) << column.trailing;
+    } else {
+        column.leading = int(readBits(5));
+        const int length = int(readBits(5)) + 1;
+        column.trailing = 32 - column.leading - length;
+        x = quint32(readBits(length)) << column.trailing;
+    }
+
+    column.previous ^= x;
+    return column.previous;
+}
+
+bool MetricBlockDecoder::next(MetricBucket &point)
+{
+    if (m_remaining <= 0) {
+        return false;
+    }
+    --m_remaining;
+
+    quint32 min;
+    if (m_first) {
+        m_timestamp = qint64(readBits(64));
+        m_pointCount = quint32(readBits(32));
+        min = quint32(readBits(32));
+        m_min.previous = min;
+    } else {
+        m_delta += readSigned();
+        m_timestamp += m_delta;
+        m_pointCount = quint32(qint64(m_pointCount) + readSigned());
+        min = readFloat(m_min);
+    }
+
+    FloatColumn *columns[] = { &m_max, &m_mean };
+    quint32 values[2];
+    for (int i = 0; i < 2; ++i) {
+        if (readBits(1) == 0) {
+            columns[i]->previous = min;
+        } else if (m_first) {
+            columns[i]->previous = quint32(readBits(32));
+        } else {
+            readFloat(*columns[i]);
+        }
+        values[i] = columns[i]->previous;
+    }
+    m_first = false;
+
+    point.timestamp = m_timestamp;
+    point.count = m_pointCount;
+    point.min = bitsFloat(min);
+    point.max = bitsFloat(values[0]);
+    point.mean = bitsFloat(values[1]);
+    return true;
+}
@@ -0,0 +1,115 @@
+#ifndef METRICBLOCK_H
+#define METRICBLOCK_H
+
+#include <QByteArray>
+#include <QtGlobal>
+
+// One point of a series. Raw points have count 1 and min == max == mean;
+// rollups summarise every sample that fell into [timestamp, timestamp + resolution).
+struct MetricBucket {
+    qint64 timestamp = 0;       // ms since epoch, start of the bucket
+    float min = 0.0f;
+    float max = 0.0f;
+    float mean = 0.0f;
+    quint32 count = 0;
+};
+
+// Sealed run of points, Gorilla-compressed
+struct MetricBlock {
+    QByteArray data;
+    int count = 0;
+    qint64 firstTimestamp = 0;
+    qint64 lastTimestamp = 0;
+};
+
+// Streaming Gorilla encoder (Pelkonen et al., VLDB 2015). Timestamps are
+// delta-of-delta coded - the scheduler's phase-aligned ticks cost one bit
+// each. Values are XOR'd with the previous value of the same column, so an
+// unchanged reading is one bit and a small change only stores the bits that
+// differ. max and mean take one bit when they equal min, as every raw point does.
+class MetricBlockEncoder
+{
+public:
+    void append(const MetricBucket &point);
+    void clear();
+
+    int count() const {
+        return m_count;
+    }
+
+    // Bytes so far - decodable as is, the open block is queried this way
+    const QByteArray &data() const {
+        return m_data;
+    }
+
+    // Copy of the current contents without spare capacity
+    MetricBlock seal() const;
+
+    qint64 firstTimestamp() const {
+        return m_firstTimestamp;
+    }
+
+    qint64 lastTimestamp() const {
+        return m_timestamp;
+    }
+
+private:
+    // Previous value and meaningful-bit window of one float column
+    struct FloatColumn {
+        quint32 previous = 0;
+        int leading = -1;       // -1 until the first window is written
+        int trailing = 0;
+    };
+
+    void writeBits(quint64 value, int count);
+    void writeSigned(qint64 value);
+    void writeFloat(FloatColumn &column, quint32 bits);
+
+    QByteArray m_data;
+    int m_bitCount = 0;
+    int m_count = 0;
+
+    qint64 m_firstTimestamp = 0;
+    qint64 m_timestamp = 0;
+    qint64 m_delta = 0;
+    quint32 m_pointCount = 0;
+    FloatColumn m_min;
+    FloatColumn m_max;
+    FloatColumn m_mean;
+};
+
+// Sequential decoder for the encoder's output
+class MetricBlockDecoder
+{
+public:
+    MetricBlockDecoder(const QByteArray &data, int count);
+
+    // False once all count points were returned
+    bool next(MetricBucket &point);
+
+private:
+    struct FloatColumn {
+        quint32 previous = 0;
+        int leading = 0;
+        int trailing = 0;
+    };
+
+    quint64 readBits(int count);
+    qint64 readSigned();
+    quint32 readFloat(FloatColumn &column);
+
+    const uchar *m_data;
+    int m_size;
+    int m_bitPosition = 0;
+    int m_remaining;
+    bool m_first = true;
+
+    qint64 m_timestamp = 0;
+    qint64 m_delta = 0;
+    quint32 m_pointCount = 0;
+    FloatColumn m_min;
+    FloatColumn m_max;
+    FloatColumn m_mean;
+};
+
+#endif // METRICBLOCK_H
@@ -0,0 +1,556 @@
+#include "metricjournal.h"
+#include "constants.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    // Layout is host byte order - segments never leave the machine
+    //
+    // Segment header (32 bytes):
+    //   0 magic  4 version  8 sequence  16 created ms  24 flags  28 crc of 0..27
+    // Record (8-byte aligned):
+    //   0 magic  4 crc of 8..end  8 first ms  16 last ms  24 count  28 data size
+    //   32 name size (16 bit)  34 tier  35..39 reserved  40 name  data  padding
+    const quint32 SEGMENT_MAGIC = 0x53484d53;   // "SMHS"
+    const quint32 RECORD_MAGIC = 0x314b4c42;    // "BLK1"
+    const quint32 FORMAT_VERSION = 1;
+    const int HEADER_SIZE = 32;
+    const int RECORD_HEADER_SIZE = 40;
+    const int MAX_TIERS = 8;
+
+    // Set once every record of the segment is on disk
+    const quint32 SEGMENT_SEALED = 0x1;
+
+    quint32 crc32(quint32 crc, const uchar *data, qint64 size)
+    {
+        static quint32 table[256];
+        static bool ready = false;
+        if (!ready) {
+            for (quint32 i = 0; i < 256; ++i) {
+                quint32 c = i;
+                for (int k = 0; k < 8; ++k) {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                table[i] = c;
+            }
+            ready = true;
+        }
+
+        crc = ~crc;
+        for (qint64 i = 0; i < size; ++i) {
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    template <typename T>
+    inline T load(const uchar *p)
+    {
+        T value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    template <typename T>
+    inline void store(uchar *p, T value)
+    {
+        std::memcpy(p, &value, sizeof(value));
+    }
+
+    inline qint64 padded(qint64 size)
+    {
+        return (size + 7) & ~qint64(7);
+    }
+
+    inline QByteArray recordKey(const QString &series, int tier)
+    {
+        return series.toUtf8() + char('0' + tier);
+    }
+}
+
+MetricJournal::MetricJournal()
+{
+}
+
+MetricJournal::~MetricJournal()
+{
+    close();
+}
+
+QString MetricJournal::segmentPath(quint64 sequence) const
+{
+    return QString("%1/segment-%2.dat").arg(m_directory).arg(sequence, 8, 10, QChar('0'));
+}
+
+QString MetricJournal::checkpointPath() const
+{
+    return m_directory + "/checkpoint.dat";
+}
+
+bool MetricJournal::mapSegment(Segment &segment, bool writable, qint64 size)
+{
+    const int fd = ::open(QFile::encodeName(segment.path).constData(),
+                          writable ? O_RDWR | O_CREAT | O_CLOEXEC : O_RDONLY | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        qWarning() << "MetricJournal: cannot open" << segment.path << strerror(errno);
+        return false;
+    }
+
+    // New segments are preallocated; existing ones are mapped as they are
+    bool ok = true;
+    if (size > 0) {
+        ok = ::ftruncate(fd, size) == 0;
+    } else {
+        struct stat st;
+        ok = ::fstat(fd, &st) == 0;
+        size = ok ? st.st_size : 0;
+    }
+
+    void *map = ok && size > 0
+        ? ::mmap(nullptr, size_t(size), PROT_READ | (writable ? PROT_WRITE : 0), MAP_SHARED, fd, 0)
+        : MAP_FAILED;
+    ::close(fd);        // The mapping keeps the file
+
+    if (map == MAP_FAILED) {
+        qWarning() << "MetricJournal: cannot map" << segment.path;
+        return false;
+    }
+
+    segment.map = static_cast<uchar *>(map);
+    segment.size = size;
+    segment.writable = writable;
+    return true;
+}
+
+void MetricJournal::unmapSegment(Segment &segment)
+{
+    if (segment.map) {
+        ::munmap(segment.map, size_t(segment.size));
+        segment.map = nullptr;
+    }
+}
+
+QByteArray MetricJournal::encodeHeader(quint64 sequence, bool sealed)
+{
+    QByteArray header(HEADER_SIZE, 0);
+    uchar *p = reinterpret_cast<uchar *>(header.data());
+    store<quint32>(p, SEGMENT_MAGIC);
+    store<quint32>(p + 4, FORMAT_VERSION);
+    store<quint64>(p + 8, sequence);
+    store<qint64>(p + 16, QDateTime::currentMSecsSinceEpoch());
+    store<quint32>(p + 24, sealed ? SEGMENT_SEALED : 0);
+    store<quint32>(p + 28, crc32(0, p, 28));
+    return header;
+}
+
+bool MetricJournal::readHeader(const uchar *base, qint64 size, quint64 &sequence, bool &sealed)
+{
+    if (size < HEADER_SIZE || load<quint32>(base) != SEGMENT_MAGIC ||
+        load<quint32>(base + 4) != FORMAT_VERSION || load<quint32>(base + 28) != crc32(0, base, 28)) {
+        return false;
+    }
+
+    sequence = load<quint64>(base + 8);
+    sealed = (load<quint32>(base + 24) & SEGMENT_SEALED) != 0;
+    return true;
+}
+
+bool MetricJournal::sealSegment(Segment &segment)
+{
+    // Records first, synchronously: the flag must never reach the disk
+    // ahead of the data it vouches for
+    if (::msync(segment.map, size_t(segment.size), MS_SYNC) != 0) {
+        qWarning() << "MetricJournal: cannot sync" << segment.path << strerror(errno);
+        return false;
+    }
+
+    // Losing this write only costs a CRC check on the next open
+    store<quint32>(segment.map + 24, load<quint32>(segment.map + 24) | SEGMENT_SEALED);
+    store<quint32>(segment.map + 28, crc32(0, segment.map, 28));
+    ::msync(segment.map, HEADER_SIZE, MS_ASYNC);
+    segment.sealed = true;
+    return true;
+}
+
+QByteArray MetricJournal::encodeRecord(const QString &series, int tier, const MetricBlock &block)
+{
+    const QByteArray name = series.toUtf8().left(0xFFFF);
+    const qint64 length = padded(RECORD_HEADER_SIZE + name.size() + block.data.size());
+
+    QByteArray record(int(length), 0);
+    uchar *p = reinterpret_cast<uchar *>(record.data());
+    store<quint32>(p, RECORD_MAGIC);
+    store<qint64>(p + 8, block.firstTimestamp);
+    store<qint64>(p + 16, block.lastTimestamp);
+    store<quint32>(p + 24, quint32(block.count));
+    store<quint32>(p + 28, quint32(block.data.size()));
+    store<quint16>(p + 32, quint16(name.size()));
+    p[34] = uchar(tier);
+    std::memcpy(p + RECORD_HEADER_SIZE, name.constData(), size_t(name.size()));
+    std::memcpy(p + RECORD_HEADER_SIZE + name.size(), block.data.constData(), size_t(block.data.size()));
+
+    const qint64 covered = RECORD_HEADER_SIZE + name.size() + block.data.size() - 8;
+    store<quint32>(p + 4, crc32(0, p + 8, covered));
+    return record;
+}
+
+bool MetricJournal::readRecord(const uchar *base, qint64 size, qint64 offset, bool verifyCrc, Record &record)
+{
+    if (offset + RECORD_HEADER_SIZE > size) {
+        return false;
+    }
+
+    const uchar *p = base + offset;
+    if (load<quint32>(p) != RECORD_MAGIC) {
+        return false;
+    }
+
+    const qint64 dataSize = load<quint32>(p + 28);
+    const qint64 nameSize = load<quint16>(p + 32);
+    const int tier = p[34];
+    const qint64 length = padded(RECORD_HEADER_SIZE + nameSize + dataSize);
+    if (offset + length > size || tier >= MAX_TIERS) {
+        return false;
+    }
+
+    if (verifyCrc && load<quint32>(p + 4) != crc32(0, p + 8, RECORD_HEADER_SIZE + nameSize + dataSize - 8)) {
+        return false;
+    }
+
+    const char *name = reinterpret_cast<const char *>(p + RECORD_HEADER_SIZE);
+    record.series = QString::fromUtf8(name, int(nameSize));
+    record.tier = tier;
+    record.block.data = QByteArray::fromRawData(name + nameSize, int(dataSize));
+    record.block.count = int(load<quint32>(p + 24));
+    record.block.firstTimestamp = load<qint64>(p + 8);
+    record.block.lastTimestamp = load<qint64>(p + 16);
+    record.offset = offset;
+    record.length = length;
+    return true;
+}
+
+bool MetricJournal::open(const QString &directory, const BlockFunction &fn, const BlockFunction &headFn)
+{
+    QMutexLocker locker(&m_mutex);
+
+    closeLocked();
+
+    if (!QDir().mkpath(directory)) {
+        qWarning() << "MetricJournal: cannot create" << directory;
+        return false;
+    }
+    m_directory = directory;
+
+    const QStringList names = QDir(directory).entryList(QStringList() << "segment-*.dat",
+                                                        QDir::Files, QDir::Name);
+
+    // Newest block end per series/tier, for the checkpoint
+    QHash<QByteArray, qint64> newest;
+    const bool haveCheckpoint = QFile::exists(checkpointPath());
+
+    for (int i = 0; i < names.size(); ++i) {
+        // The newest segment is reopened for writing
+        const bool last = i == names.size() - 1;
+
+        Segment segment;
+        segment.path = directory + "/" + names[i];
+        if (!mapSegment(segment, last, 0)) {
+            continue;
+        }
+        if (!readHeader(segment.map, segment.size, segment.sequence, segment.sealed)) {
+            qWarning() << "MetricJournal: ignoring damaged segment" << segment.path;
+            unmapSegment(segment);
+            continue;
+        }
+
+        // A sealed segment was synced before the flag was set. Any other one
+        // - the newest, or one whose sync a crash cut short - may hold torn
+        // records and is CRC-checked up to the first bad one.
+        const bool verifyCrc = !segment.sealed;
+        if (verifyCrc && !last) {
+            qWarning() << "MetricJournal: checking unsealed segment" << segment.path;
+        }
+
+        // The only walk over the records
+        Record record;
+        qint64 offset = HEADER_SIZE;
+        while (readRecord(segment.map, segment.size, offset, verifyCrc, record)) {
+            offset += record.length;
+            fn(record.series, record.tier, record.block);
+            if (haveCheckpoint) {
+                newest.insert(recordKey(record.series, record.tier), record.block.lastTimestamp);
+            }
+        }
+        segment.used = offset;
+        segment.pinned = true;
+        m_segments.append(segment);
+    }
+
+    if ((m_segments.isEmpty() || !m_segments.last().writable || m_segments.last().sealed) && !startSegment()) {
+        closeLocked();
+        return false;
+    }
+
+    restoreCheckpoint(newest, headFn);
+
+    qDebug() << "MetricJournal:" << m_segments.size() << "segments," << diskUsageLocked() / 1024
+             << "KB in" << directory;
+    return true;
+}
+
+void MetricJournal::close()
+{
+    QMutexLocker locker(&m_mutex);
+    closeLocked();
+}
+
+bool MetricJournal::isOpen() const
+{
+    QMutexLocker locker(&m_mutex);
+    return !m_directory.isEmpty();
+}
+
+int MetricJournal::segmentCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_segments.size();
+}
+
+void MetricJournal::closeLocked()
+{
+    for (Segment &segment : m_segments) {
+        unmapSegment(segment);
+    }
+    for (Segment &segment : m_retired) {
+        unmapSegment(segment);
+    }
+    m_segments.clear();
+    m_retired.clear();
+    m_directory.clear();
+}
+
+bool MetricJournal::startSegment()
+{
+    Segment segment;
+    segment.sequence = m_segments.isEmpty() ? 1 : m_segments.last().sequence + 1;
+    segment.path = segmentPath(segment.sequence);
+
+    if (!mapSegment(segment, true, Constants::METRIC_SEGMENT_SIZE)) {
+        return false;
+    }
+
+    const QByteArray header = encodeHeader(segment.sequence, false);
+    std::memcpy(segment.map, header.constData(), HEADER_SIZE);
+    segment.used = HEADER_SIZE;
+
+    // The full segment is never written again - flush and seal it
+    if (!m_segments.isEmpty()) {
+        Segment &previous = m_segments.last();
+        if (previous.writable && !previous.sealed) {
+            sealSegment(previous);
+        }
+        previous.writable = false;
+    }
+
+    m_segments.append(segment);
+    return true;
+}
+
+bool MetricJournal::append(const QString &series, int tier, const MetricBlock &block)
+{
+    QMutexLocker locker(&m_mutex);
+    return appendLocked(series, tier, block);
+}
+
+bool MetricJournal::appendLocked(const QString &series, int tier, const MetricBlock &block)
+{
+    if (m_directory.isEmpty() || block.count <= 0) {
+        return false;
+    }
+
+    const QByteArray record = encodeRecord(series, tier, block);
+    if (record.size() > Constants::METRIC_SEGMENT_SIZE - HEADER_SIZE) {
+        return false;
+    }
+
+    if (m_segments.last().used + record.size() > m_segments.last().size && !startSegment()) {
+        return false;
+    }
+
+    // A crash mid-copy leaves a record that fails its CRC on the next open
+    Segment &segment = m_segments.last();
+    std::memcpy(segment.map + segment.used, record.constData(), size_t(record.size()));
+    segment.used += record.size();
+    return true;
+}
+
+bool MetricJournal::checkpoint(const QVector<Head> &heads)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_directory.isEmpty()) {
+        return false;
+    }
+
+    if (heads.isEmpty()) {
+        QFile::remove(checkpointPath());
+        return true;
+    }
+
+    QByteArray contents = encodeHeader(0, false);
+    for (const Head &head : heads) {
+        contents += encodeRecord(head.series, head.tier, head.block);
+    }
+
+    // Written beside and renamed over - a crash leaves the old or the new one
+    QSaveFile file(checkpointPath());
+    if (!file.open(QIODevice::WriteOnly) || file.write(contents) != contents.size() || !file.commit()) {
+        qWarning() << "MetricJournal: checkpoint failed -" << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+void MetricJournal::restoreCheckpoint(const QHash<QByteArray, qint64> &newest, const BlockFunction &headFn)
+{
+    QFile file(checkpointPath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    const QByteArray contents = file.readAll();
+    file.close();
+
+    const uchar *base = reinterpret_cast<const uchar *>(contents.constData());
+    quint64 sequence;
+    bool sealed;
+    if (!readHeader(base, contents.size(), sequence, sealed)) {
+        QFile::remove(checkpointPath());
+        return;
+    }
+
+    // A head sealed after the checkpoint was taken is already in a segment.
+    // The file stays until the next checkpoint replaces it - the heads are
+    // only in memory again, not on disk.
+    int restored = 0;
+    Record record;
+    for (qint64 offset = HEADER_SIZE; readRecord(base, contents.size(), offset, true, record);
+         offset += record.length) {
+        const QByteArray key = recordKey(record.series, record.tier);
+        if (record.block.firstTimestamp <= newest.value(key, -1)) {
+            continue;
+        }
+        headFn(record.series, record.tier, record.block);
+        ++restored;
+    }
+
+    qDebug() << "MetricJournal: restored" << restored << "unsealed blocks from the checkpoint";
+}
+
+void MetricJournal::retire(Segment &segment)
+{
+    // Blocks in the store may still point into a mapping handed out at startup
+    if (segment.pinned) {
+        m_retired.append(segment);
+    } else {
+        unmapSegment(segment);
+    }
+    segment.map = nullptr;
+}
+
+bool MetricJournal::rewriteSegment(Segment &segment, const QVector<Record> &live)
+{
+    // QSaveFile::commit() syncs before the rename, so the copy is sealed
+    QByteArray contents = encodeHeader(segment.sequence, true);
+    for (const Record &record : live) {
+        contents.append(reinterpret_cast<const char *>(segment.map + record.offset), int(record.length));
+    }
+
+    QSaveFile file(segment.path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(contents) != contents.size() || !file.commit()) {
+        qWarning() << "MetricJournal: compaction of" << segment.path << "failed -" << file.errorString();
+        return false;
+    }
+
+    Segment compacted;
+    compacted.path = segment.path;
+    compacted.sequence = segment.sequence;
+    if (!mapSegment(compacted, false, 0)) {
+        return false;
+    }
+    compacted.used = contents.size();
+    compacted.sealed = true;
+
+    retire(segment);
+    segment = compacted;
+    return true;
+}
+
+void MetricJournal::compact(const QVector<qint64> &expiry)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_directory.isEmpty()) {
+        return;
+    }
+
+    const qint64 before = diskUsageLocked();
+    int removed = 0;
+    int rewritten = 0;
+
+    // The newest segment is still being written - leave it alone
+    for (int i = m_segments.size() - 2; i >= 0; --i) {
+        Segment &segment = m_segments[i];
+
+        QVector<Record> live;
+        qint64 liveBytes = 0;
+        Record record;
+        for (qint64 offset = HEADER_SIZE; offset < segment.used; offset += record.length) {
+            if (!readRecord(segment.map, segment.used, offset, false, record)) {
+                break;
+            }
+            if (record.tier >= expiry.size() || record.block.lastTimestamp >= expiry[record.tier]) {
+                live.append(record);
+                liveBytes += record.length;
+            }
+        }
+
+        if (live.isEmpty()) {
+            QFile::remove(segment.path);
+            retire(segment);
+            m_segments.remove(i);
+            ++removed;
+        } else if (liveBytes * 2 < segment.used && rewriteSegment(segment, live)) {
+            ++rewritten;
+        }
+    }
+
+    if (removed > 0 || rewritten > 0) {
+        qDebug() << "MetricJournal: compaction removed" << removed << "and rewrote" << rewritten
+                 << "segments," << before / 1024 << "->" << diskUsageLocked() / 1024 << "KB";
+    }
+}
+
+qint64 MetricJournal::diskUsage() const
+{
+    QMutexLocker locker(&m_mutex);
+    return diskUsageLocked();
+}
+
+qint64 MetricJournal::diskUsageLocked() const
+{
+    qint64 bytes = 0;
+    for (const Segment &segment : m_segments) {
+        bytes += segment.size;
+    }
+    return bytes;
+}
@@ -0,0 +1,115 @@
+#ifndef METRICJOURNAL_H
+#define METRICJOURNAL_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <functional>
+#include "metricblock.h"
+
+// On-disk home of the MetricStore's sealed blocks, so history survives a
+// restart. Blocks are appended to fixed-size, memory-mapped segment files
+// ("segment-NNNNNNNN.dat"); a full segment is left as is and the next one
+// created. Every record carries a CRC, so a record torn by a crash is found
+// at the tail of the newest segment and writing resumes in front of it. A
+// full segment is synced and then marked sealed in its header; segments
+// without the mark are CRC-checked on open like the newest one.
+//
+// On open the segments are mapped and walked once - the blocks handed to
+// the open() callback point straight into the mapping, nothing is decoded
+// or copied. Those mappings stay alive until the journal is destroyed, even
+// if compaction removes the file.
+//
+// Blocks still being filled are not in the segments; checkpoint() saves
+// them to a small side file (write + rename) now and then. open() hands
+// them back separately so the store can keep filling them - they reach a
+// segment only once sealed, like any other block.
+//
+// Locked internally and apart from the MetricStore, so disk I/O never holds
+// up a GUI-thread query of the store.
+class MetricJournal
+{
+public:
+    // Unsealed block of one series/tier, for checkpoint()
+    struct Head {
+        QString series;
+        int tier = 0;
+        MetricBlock block;
+    };
+
+    typedef std::function<void(const QString &series, int tier, const MetricBlock &block)> BlockFunction;
+
+    MetricJournal();
+    ~MetricJournal();
+
+    // Maps every segment in directory (created if needed) and passes each
+    // stored block to fn, oldest segment first. The blocks point into the
+    // mappings, which are kept until close(). Checkpointed heads not sealed
+    // since go to headFn last; their data is only valid during the call.
+    bool open(const QString &directory, const BlockFunction &fn, const BlockFunction &headFn);
+    void close();
+
+    bool isOpen() const;
+
+    // Append a sealed block to the newest segment, rotating when full
+    bool append(const QString &series, int tier, const MetricBlock &block);
+
+    // Replace the checkpoint file with these heads
+    bool checkpoint(const QVector<Head> &heads);
+
+    // Delete segments whose blocks all ended before expiry[tier] and rewrite
+    // the ones that are mostly expired
+    void compact(const QVector<qint64> &expiry);
+
+    int segmentCount() const;
+    qint64 diskUsage() const;
+
+private:
+    struct Segment {
+        QString path;
+        quint64 sequence = 0;
+        uchar *map = nullptr;
+        qint64 size = 0;
+        qint64 used = 0;            // End of the last valid record
+        bool writable = false;
+        bool sealed = false;        // Synced in full, records need no CRC check
+        bool pinned = false;        // Blocks handed out point into the mapping
+    };
+
+    // Parsed record header, data points into the segment or buffer
+    struct Record {
+        QString series;
+        int tier = 0;
+        MetricBlock block;
+        qint64 offset = 0;
+        qint64 length = 0;          // Header, name, data and padding
+    };
+
+    static bool mapSegment(Segment &segment, bool writable, qint64 size);
+    static void unmapSegment(Segment &segment);
+    static QByteArray encodeHeader(quint64 sequence, bool sealed);
+    static QByteArray encodeRecord(const QString &series, int tier, const MetricBlock &block);
+    // Reads the record at offset; verifyCrc is skipped for sealed segments
+    static bool readRecord(const uchar *base, qint64 size, qint64 offset, bool verifyCrc, Record &record);
+    static bool readHeader(const uchar *base, qint64 size, quint64 &sequence, bool &sealed);
+    static bool sealSegment(Segment &segment);
+
+    void closeLocked();
+    bool appendLocked(const QString &series, int tier, const MetricBlock &block);
+    qint64 diskUsageLocked() const;
+    QString segmentPath(quint64 sequence) const;
+    QString checkpointPath() const;
+    bool startSegment();
+    void restoreCheckpoint(const QHash<QByteArray, qint64> &newest, const BlockFunction &headFn);
+    bool rewriteSegment(Segment &segment, const QVector<Record> &live);
+    void retire(Segment &segment);
+
+    mutable QMutex m_mutex;
+    QString m_directory;
+    QVector<Segment> m_segments;    // Sequence order, the last one is written
+    QVector<Segment> m_retired;     // Removed from disk, still referenced
+};
+
+#endif // METRICJOURNAL_H
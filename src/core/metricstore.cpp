@@ -0,0 +1,524 @@
+#include "metricstore.h"
+#include "constants.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QMutexLocker>
+#include <cmath>
+
+namespace {
+    // Appends the points of one block that fall into [fromMs, toMs]
+    void decodeRange(const QByteArray &data, int count, qint64 fromMs, qint64 toMs,
+                     QVector<MetricBucket> &result)
+    {
+        MetricBlockDecoder decoder(data, count);
+        MetricBucket point;
+        while (decoder.next(point)) {
+            if (point.timestamp > toMs) {
+                return;
+            }
+            if (point.timestamp >= fromMs) {
+                result.append(point);
+            }
+        }
+    }
+}
+
+MetricStore::MetricStore()
+{
+    m_windowLengths << Constants::METRIC_WINDOW_SHORT << Constants::METRIC_WINDOW_MEDIUM
+                    << Constants::METRIC_WINDOW_LONG;
+
+    qDebug() << "MetricStore: at most" << Constants::METRIC_STORE_MAX_SERIES << "series,"
+             << Constants::METRIC_BLOCK_POINTS << "points per block";
+}
+
+MetricStore::~MetricStore()
+{
+    qDeleteAll(m_series);
+}
+
+bool MetricStore::openJournal(const QString &directory)
+{
+    // Blocks are used in place - they point into the segment mappings.
+    // Mapping and walking the segments happens outside our lock.
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QVector<MetricJournal::Head> blocks;
+    QVector<MetricJournal::Head> heads;
+    const bool opened = m_journal.open(directory, [now, &blocks](const QString &name, int tier,
+                                                                 const MetricBlock &block) {
+        if (tier < TierCount && block.lastTimestamp >= now - retention(Tier(tier))) {
+            MetricJournal::Head head;
+            head.series = name;
+            head.tier = tier;
+            head.block = block;
+            blocks.append(head);
+        }
+    }, [now, &heads](const QString &name, int tier, const MetricBlock &block) {
+        // Checkpoint buffer is freed after open() - keep a copy
+        if (tier < TierCount && block.lastTimestamp >= now - retention(Tier(tier))) {
+            MetricJournal::Head head;
+            head.series = name;
+            head.tier = tier;
+            head.block = block;
+            head.block.data = QByteArray(block.data.constData(), block.data.size());
+            heads.append(head);
+        }
+    });
+    if (!opened) {
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    int restored = 0;
+    for (const MetricJournal::Head &head : blocks) {
+        const int tier = head.tier;
+        const MetricBlock &block = head.block;
+        Series *series = seriesFor(head.series);
+        if (!series) {
+            continue;
+        }
+
+        RingBuffer<MetricBlock> &sealed = series->tiers[tier].sealed;
+        if (!sealed.isEmpty() && block.firstTimestamp <= sealed.last().lastTimestamp) {
+            continue;   // Overlaps what we have - keep the rings ordered
+        }
+
+        sealed.append(block);
+        series->newest = qMax(series->newest, block.lastTimestamp);
+        ++restored;
+    }
+
+    // latest() answers from the newest raw point on disk
+    for (Series *series : m_series) {
+        const RingBuffer<MetricBlock> &raw = series->tiers[Raw].sealed;
+        if (!raw.isEmpty()) {
+            MetricBlockDecoder decoder(raw.last().data, raw.last().count);
+            while (decoder.next(series->last)) {
+            }
+        }
+    }
+
+    // Heads are filled on where they left off rather than sealed short, so
+    // a restart does not cost a ring slot per series and tier
+    int merged = 0;
+    for (const MetricJournal::Head &head : heads) {
+        Series *series = seriesFor(head.series);
+        if (!series) {
+            continue;
+        }
+
+        TierData &data = series->tiers[head.tier];
+        if (data.head.count() > 0 ||
+            (!data.sealed.isEmpty() && head.block.firstTimestamp <= data.sealed.last().lastTimestamp)) {
+            continue;
+        }
+
+        MetricBlockDecoder decoder(head.block.data, head.block.count);
+        MetricBucket point;
+        while (decoder.next(point)) {
+            appendPoint(*series, Tier(head.tier), point);
+            if (head.tier == Raw) {
+                series->last = point;
+            }
+        }
+        series->newest = qMax(series->newest, head.block.lastTimestamp);
+        ++merged;
+    }
+
+    qDebug() << "MetricStore: restored" << restored << "blocks and" << merged << "unsealed heads of"
+             << m_series.size() << "series";
+
+    // Only a head of a full block's length seals here
+    writeSealed(locker);
+    return true;
+}
+
+void MetricStore::checkpoint()
+{
+    if (!m_journal.isOpen()) {
+        return;
+    }
+
+    // Copies of the heads under the lock, the file is written after it
+    QVector<MetricJournal::Head> heads;
+    QMutexLocker locker(&m_mutex);
+    for (const Series *series : m_series) {
+        for (int t = 0; t < TierCount; ++t) {
+            if (series->tiers[t].head.count() > 0) {
+                MetricJournal::Head head;
+                head.series = series->name;
+                head.tier = t;
+                head.block = series->tiers[t].head.seal();
+                heads.append(head);
+            }
+        }
+    }
+    locker.unlock();
+
+    m_journal.checkpoint(heads);
+}
+
+void MetricStore::compact(qint64 nowMs)
+{
+    // Retention is fixed - nothing of ours to lock
+    QVector<qint64> expiry;
+    for (int t = 0; t < TierCount; ++t) {
+        expiry.append(nowMs - retention(Tier(t)));
+    }
+    m_journal.compact(expiry);
+}
+
+qint64 MetricStore::diskUsage() const
+{
+    return m_journal.diskUsage();
+}
+
+qint64 MetricStore::resolution(Tier tier)
+{
+    switch (tier) {
+    case Medium:
+        return Constants::METRIC_MEDIUM_RESOLUTION;
+    case Long:
+        return Constants::METRIC_LONG_RESOLUTION;
+    default:
+        return 0;
+    }
+}
+
+qint64 MetricStore::retention(Tier tier)
+{
+    switch (tier) {
+    case Medium:
+        return Constants::METRIC_MEDIUM_RETENTION;
+    case Long:
+        return Constants::METRIC_LONG_RETENTION;
+    default:
+        return Constants::METRIC_RAW_RETENTION;
+    }
+}
+
+int MetricStore::blockCapacity(Tier tier)
+{
+    // Raw points arrive at most once per scheduler tick
+    const qint64 step = tier == Raw ? Constants::UPDATE_INTERVAL : resolution(tier);
+    const qint64 points = retention(tier) / step;
+    return int((points + Constants::METRIC_BLOCK_POINTS - 1) / Constants::METRIC_BLOCK_POINTS);
+}
+
+qint64 MetricStore::memoryUsage() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    qint64 bytes = 0;
+    for (const Series *series : m_series) {
+        bytes += sizeof(Series);
+        for (const TierData &tier : series->tiers) {
+            bytes += qint64(tier.sealed.capacity()) * sizeof(MetricBlock) + tier.head.data().capacity();
+            tier.sealed.forEach([&bytes](const MetricBlock &block) {
+                bytes += block.data.size();
+            });
+        }
+    }
+    return bytes;
+}
+
+qint64 MetricStore::uncompressedSize() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    qint64 points = 0;
+    for (const Series *series : m_series) {
+        for (const TierData &tier : series->tiers) {
+            points += tier.head.count();
+            tier.sealed.forEach([&points](const MetricBlock &block) {
+                points += block.count;
+            });
+        }
+    }
+    return points * qint64(sizeof(MetricBucket));
+}
+
+MetricBucket MetricStore::seal(const Accumulator &accumulator)
+{
+    MetricBucket bucket;
+    bucket.timestamp = accumulator.start;
+    bucket.min = float(accumulator.min);
+    bucket.max = float(accumulator.max);
+    bucket.mean = accumulator.count > 0 ? float(accumulator.sum / accumulator.count) : 0.0f;
+    bucket.count = accumulator.count;
+    return bucket;
+}
+
+MetricStore::Series *MetricStore::seriesFor(const QString &name)
+{
+    const int index = m_index.value(name, -1);
+    if (index >= 0) {
+        return m_series[index];
+    }
+
+    if (m_series.size() >= Constants::METRIC_STORE_MAX_SERIES) {
+        if (!m_warnedFull) {
+            qWarning() << "MetricStore full, not recording" << name << "and later series";
+            m_warnedFull = true;
+        }
+        return nullptr;
+    }
+
+    // Block rings sized up front - the point count per tier never grows
+    Series *series = new Series;
+    series->name = name;
+    for (int t = 0; t < TierCount; ++t) {
+        series->tiers[t].sealed.setCapacity(blockCapacity(Tier(t)));
+    }
+    for (qint64 length : m_windowLengths) {
+        series->windows.append(SlidingWindow(length));
+    }
+
+    m_index.insert(name, m_series.size());
+    m_series.append(series);
+    return series;
+}
+
+void MetricStore::append(qint64 timestampMs, const QHash<QString, double> &values)
+{
+    QMutexLocker locker(&m_mutex);
+
+    for (auto it = values.constBegin(); it != values.constEnd(); ++it) {
+        Series *series = seriesFor(it.key());
+        if (series) {
+            appendLocked(*series, timestampMs, it.value());
+        }
+    }
+
+    writeSealed(locker);
+}
+
+void MetricStore::append(const QString &name, qint64 timestampMs, double value)
+{
+    QMutexLocker locker(&m_mutex);
+
+    Series *series = seriesFor(name);
+    if (series) {
+        appendLocked(*series, timestampMs, value);
+    }
+
+    writeSealed(locker);
+}
+
+void MetricStore::writeSealed(QMutexLocker &locker)
+{
+    if (m_unwritten.isEmpty()) {
+        return;
+    }
+
+    // A segment rotation syncs a whole segment - never under our lock
+    QVector<MetricJournal::Head> blocks;
+    blocks.swap(m_unwritten);
+    locker.unlock();
+
+    for (const MetricJournal::Head &block : blocks) {
+        m_journal.append(block.series, block.tier, block.block);
+    }
+}
+
+void MetricStore::appendLocked(Series &series, qint64 timestampMs, double value)
+{
+    if (!std::isfinite(value)) {
+        return;
+    }
+
+    // Wall clock stepped back - drop samples until it passes the newest
+    // point again, so the blocks stay ordered and no history is lost
+    if (timestampMs < series.newest) {
+        if (!m_clockBehind) {
+            qDebug() << "MetricStore: clock went back" << (series.newest - timestampMs)
+                     << "ms, dropping samples until it catches up";
+            m_clockBehind = true;
+        }
+        return;
+    }
+    m_clockBehind = false;
+
+    MetricBucket point;
+    point.timestamp = timestampMs;
+    point.min = point.max = point.mean = float(value);
+    point.count = 1;
+    appendPoint(series, Raw, point);
+    series.last = point;
+    series.newest = timestampMs;
+
+    for (SlidingWindow &window : series.windows) {
+        window.add(timestampMs, value);
+    }
+
+    // Roll up at insert time: seal the open bucket once a sample lands past it
+    for (int t = Raw + 1; t < TierCount; ++t) {
+        const qint64 width = resolution(Tier(t));
+        const qint64 start = timestampMs - timestampMs % width;
+        Accumulator &open = series.open[t];
+
+        if (open.count > 0 && open.start != start) {
+            appendPoint(series, Tier(t), seal(open));
+            open = Accumulator();
+        }
+
+        if (open.count == 0) {
+            open.start = start;
+            open.min = value;
+            open.max = value;
+        } else {
+            open.min = qMin(open.min, value);
+            open.max = qMax(open.max, value);
+        }
+        open.sum += value;
+        ++open.count;
+    }
+}
+
+void MetricStore::appendPoint(Series &series, Tier tier, const MetricBucket &point)
+{
+    TierData &data = series.tiers[tier];
+    data.head.append(point);
+
+    // Seal full blocks; the oldest one drops out of the ring
+    if (data.head.count() >= Constants::METRIC_BLOCK_POINTS) {
+        const MetricBlock block = data.head.seal();
+        data.sealed.append(block);
+        data.head.clear();
+
+        MetricJournal::Head sealed;
+        sealed.series = series.name;
+        sealed.tier = tier;
+        sealed.block = block;
+        m_unwritten.append(sealed);
+    }
+}
+
+QVector<MetricBucket> MetricStore::query(const QString &name, qint64 fromMs, qint64 toMs) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    const int index = m_index.value(name, -1);
+    if (index < 0) {
+        return QVector<MetricBucket>();
+    }
+
+    // Finest tier whose retention reaches back to fromMs
+    const Series &series = *m_series[index];
+    Tier tier = Long;
+    for (int t = Raw; t < TierCount; ++t) {
+        if (series.newest - fromMs <= retention(Tier(t))) {
+            tier = Tier(t);
+            break;
+        }
+    }
+
+    return queryLocked(series, tier, fromMs, toMs);
+}
+
+QVector<MetricBucket> MetricStore::query(const QString &name, Tier tier, qint64 fromMs, qint64 toMs) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    const int index = m_index.value(name, -1);
+    if (index < 0) {
+        return QVector<MetricBucket>();
+    }
+
+    return queryLocked(*m_series[index], tier, fromMs, toMs);
+}
+
+QVector<MetricBucket> MetricStore::queryLocked(const Series &series, Tier tier, qint64 fromMs, qint64 toMs) const
+{
+    QVector<MetricBucket> result;
+    const TierData &data = series.tiers[tier];
+
+    // A rollup bucket belongs to the range if any part of it overlaps
+    const qint64 from = tier == Raw ? fromMs : fromMs - resolution(tier) + 1;
+
+    // Only blocks overlapping the range are decoded
+    for (int i = 0; i < data.sealed.size(); ++i) {
+        const MetricBlock &block = data.sealed.at(i);
+        if (block.firstTimestamp > toMs) {
+            return result;
+        }
+        if (block.lastTimestamp >= from) {
+            decodeRange(block.data, block.count, from, toMs, result);
+        }
+    }
+    if (data.head.count() > 0 && data.head.lastTimestamp() >= from) {
+        decodeRange(data.head.data(), data.head.count(), from, toMs, result);
+    }
+
+    const Accumulator &open = series.open[tier];
+    if (tier != Raw && open.count > 0 && open.start >= from && open.start <= toMs) {
+        result.append(seal(open));
+    }
+
+    return result;
+}
+
+bool MetricStore::latest(const QString &name, MetricBucket &point) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    const int index = m_index.value(name, -1);
+    if (index < 0 || m_series[index]->last.count == 0) {
+        return false;
+    }
+
+    point = m_series[index]->last;
+    return true;
+}
+
+bool MetricStore::windowStats(const QString &name, qint64 lengthMs, WindowStats &stats) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    const int index = m_index.value(name, -1);
+    const int window = m_windowLengths.indexOf(lengthMs);
+    if (index < 0 || window < 0) {
+        return false;
+    }
+
+    stats = m_series[index]->windows[window].stats();
+    return stats.count > 0;
+}
+
+void MetricStore::addWindow(qint64 lengthMs)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (lengthMs <= 0 || m_windowLengths.contains(lengthMs)) {
+        return;
+    }
+
+    m_windowLengths.append(lengthMs);
+    for (Series *series : m_series) {
+        series->windows.append(SlidingWindow(lengthMs));
+    }
+}
+
+QVector<qint64> MetricStore::windowLengths() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_windowLengths;
+}
+
+QStringList MetricStore::seriesNames() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    QStringList names;
+    for (const Series *series : m_series) {
+        names.append(series->name);
+    }
+    return names;
+}
+
+int MetricStore::seriesCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_series.size();
+}
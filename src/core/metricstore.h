@@ -0,0 +1,127 @@
+#ifndef METRICSTORE_H
+#define METRICSTORE_H
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "metricblock.h"
+#include "metricjournal.h"
+#include "ringbuffer.h"
+#include "slidingwindow.h"
+
+// In-memory time-series store with tiered retention: raw samples for a
+// short window, then 10 s and 5 min min/avg/max rollups for the day and the
+// month. Rollups are built incrementally as samples arrive. Each tier is a
+// ring of Gorilla-compressed blocks plus the block being filled; the rings
+// hold a fixed number of points and the series count is capped, so nothing
+// grows with uptime. With a journal attached, sealed blocks also go to disk
+// and are mapped back in on the next start; that I/O runs outside the
+// store's lock.
+//
+// Each series also keeps sliding windows (10 s, 1 min, 5 min by default),
+// updated in O(1) per sample, so windowStats() answers without a query.
+//
+// Written on the sampler thread, queried from the GUI thread.
+class MetricStore
+{
+public:
+    enum Tier {
+        Raw,
+        Medium,
+        Long,
+        TierCount
+    };
+
+    MetricStore();
+    ~MetricStore();
+
+    // Persist sealed blocks in directory and load what it already holds
+    bool openJournal(const QString &directory);
+    // Save the blocks still being filled (periodically and at shutdown)
+    void checkpoint();
+    // Drop on-disk blocks past their tier's retention
+    void compact(qint64 nowMs);
+
+    // Add one sample per series; new names create series until the cap
+    void append(qint64 timestampMs, const QHash<QString, double> &values);
+    void append(const QString &name, qint64 timestampMs, double value);
+
+    // Points of [fromMs, toMs] from the finest tier that still covers fromMs.
+    // Rollup tiers include the bucket still being filled as the last point.
+    QVector<MetricBucket> query(const QString &name, qint64 fromMs, qint64 toMs) const;
+    QVector<MetricBucket> query(const QString &name, Tier tier, qint64 fromMs, qint64 toMs) const;
+
+    // Most recent raw sample, false if the series is unknown or empty
+    bool latest(const QString &name, MetricBucket &point) const;
+
+    // Aggregates over the last lengthMs; false unless that window is tracked
+    bool windowStats(const QString &name, qint64 lengthMs, WindowStats &stats) const;
+
+    // Track another window length for every series, filled from now on
+    void addWindow(qint64 lengthMs);
+    QVector<qint64> windowLengths() const;
+
+    QStringList seriesNames() const;
+    int seriesCount() const;
+
+    // Bucket width (0 for raw) and retention per tier
+    static qint64 resolution(Tier tier);
+    static qint64 retention(Tier tier);
+
+    // Bytes held by all series, and what the same points would take as
+    // plain MetricBuckets
+    qint64 memoryUsage() const;
+    qint64 uncompressedSize() const;
+    qint64 diskUsage() const;
+
+private:
+    // Rollup bucket still being filled
+    struct Accumulator {
+        qint64 start = 0;
+        double min = 0.0;
+        double max = 0.0;
+        double sum = 0.0;
+        quint32 count = 0;
+    };
+
+    struct TierData {
+        RingBuffer<MetricBlock> sealed;
+        MetricBlockEncoder head;        // Block being filled
+    };
+
+    struct Series {
+        QString name;
+        MetricBucket last;              // Newest raw point, count 0 if none
+        qint64 newest = 0;              // Newest timestamp in any tier
+        TierData tiers[TierCount];
+        Accumulator open[TierCount];    // Unused for Raw
+        QVector<SlidingWindow> windows; // Same order as m_windowLengths
+    };
+
+    static int blockCapacity(Tier tier);
+    static MetricBucket seal(const Accumulator &accumulator);
+    Series *seriesFor(const QString &name);
+    void appendLocked(Series &series, qint64 timestampMs, double value);
+    void appendPoint(Series &series, Tier tier, const MetricBucket &point);
+    // Hands blocks sealed under the lock to the journal, after unlocking
+    void writeSealed(QMutexLocker &locker);
+    QVector<MetricBucket> queryLocked(const Series &series, Tier tier, qint64 fromMs, qint64 toMs) const;
+
+    mutable QMutex m_mutex;
+    QVector<Series *> m_series;
+    QHash<QString, int> m_index;
+    QVector<qint64> m_windowLengths;
+    bool m_warnedFull = false;
+    bool m_clockBehind = false;     // Dropping samples older than the newest
+    MetricJournal m_journal;                    // Locked on its own
+    QVector<MetricJournal::Head> m_unwritten;   // Sealed, not yet journaled
+
+    // Disable copy constructor/assignment - owns the series
+    MetricStore(const MetricStore &) = delete;
+    MetricStore &operator=(const MetricStore &) = delete;
+};
+
+#endif // METRICSTORE_H
@@ -0,0 +1,130 @@
+#include "mountparser.h"
+#include <cstring>
+
+namespace {
+    // Next space separated field of [p, end), advances p past it
+    inline ByteView nextField(const char *&p, const char *end)
+    {
+        while (p < end && *p == ' ') {
+            ++p;
+        }
+
+        ByteView field;
+        field.data = p;
+        while (p < end && *p != ' ') {
+            ++p;
+        }
+        field.size = int(p - field.data);
+
+        return field;
+    }
+
+    inline bool equals(const ByteView &field, const char *text)
+    {
+        const int length = int(std::strlen(text));
+        return field.size == length && std::memcmp(field.data, text, length) == 0;
+    }
+
+    inline bool startsWith(const ByteView &field, const char *prefix)
+    {
+        const int length = int(std::strlen(prefix));
+        return field.size >= length && std::memcmp(field.data, prefix, length) == 0;
+    }
+
+    // Loop-mounted images (snaps, ISOs) are read-only and always full
+    const char *const PSEUDO_FILESYSTEMS[] = {
+        "autofs", "binfmt_misc", "bpf", "cgroup", "cgroup2", "configfs",
+        "debugfs", "devpts", "devtmpfs", "efivarfs", "fusectl", "hugetlbfs",
+        "mqueue", "nsfs", "overlay", "proc", "pstore", "ramfs", "rpc_pipefs",
+        "securityfs", "selinuxfs", "squashfs", "sysfs", "tmpfs", "tracefs"
+    };
+
+    // Real storage without a /dev device name: network shares and ZFS datasets
+    const char *const DEVICELESS_FILESYSTEMS[] = {
+        "nfs", "nfs4", "cifs", "smb3", "smbfs", "ceph", "glusterfs", "9p", "zfs"
+    };
+}
+
+int MountParser::parse(const ByteView &bytes, QVector<MountEntry> &out)
+{
+    const char *p = bytes.begin();
+    const char *end = bytes.end();
+
+    // Format: "device mountpoint fstype options dump pass"
+    int count = 0;
+    while (p < end) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+
+        MountEntry entry;
+        entry.device = nextField(p, lineEnd);
+        entry.mountPoint = nextField(p, lineEnd);
+        entry.fsType = nextField(p, lineEnd);
+        entry.options = nextField(p, lineEnd);
+
+        if (!entry.fsType.isEmpty()) {
+            if (count < out.size()) {
+                out[count] = entry;
+            }
+            else {
+                out.append(entry);
+            }
+            ++count;
+        }
+
+        p = lineEnd + 1;
+    }
+
+    if (out.size() != count) {
+        out.resize(count);
+    }
+
+    return count;
+}
+
+QString MountParser::decodePath(const ByteView &field)
+{
+    QByteArray decoded;
+    decoded.reserve(field.size);
+
+    const char *p = field.begin();
+    const char *end = field.end();
+    while (p < end) {
+        if (*p == '\\' && end - p >= 4 &&
+            p[1] >= '0' && p[1] <= '7' && p[2] >= '0' && p[2] <= '7' && p[3] >= '0' && p[3] <= '7') {
+            decoded.append(char((p[1] - '0') * 64 + (p[2] - '0') * 8 + (p[3] - '0')));
+            p += 4;
+        }
+        else {
+            decoded.append(*p++);
+        }
+    }
+
+    return QString::fromLocal8Bit(decoded);
+}
+
+bool MountParser::isRealFilesystem(const MountEntry &entry)
+{
+    for (const char *pseudo : PSEUDO_FILESYSTEMS) {
+        if (equals(entry.fsType, pseudo)) {
+            return false;
+        }
+    }
+
+    if (startsWith(entry.device, "/dev/")) {
+        return true;
+    }
+
+    for (const char *deviceless : DEVICELESS_FILESYSTEMS) {
+        if (equals(entry.fsType, deviceless)) {
+            return true;
+        }
+    }
+
+    // fuse.sshfs, fuse.rclone, ... but not the gvfs/portal helpers
+    return startsWith(entry.fsType, "fuse.")
+           && !equals(entry.fsType, "fuse.gvfsd-fuse")
+           && !equals(entry.fsType, "fuse.portal");
+}
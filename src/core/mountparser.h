@@ -0,0 +1,33 @@
+#ifndef MOUNTPARSER_H
+#define MOUNTPARSER_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QVector>
+#include "byteview.h"
+
+// One /proc/mounts line. Fields point into the parsed buffer and are still
+// octal-escaped (a space in a path reads "\040").
+struct MountEntry {
+    ByteView device;
+    ByteView mountPoint;
+    ByteView fsType;
+    ByteView options;
+};
+
+// Single-pass /proc/mounts parser, fills a reused table without allocating
+class MountParser
+{
+public:
+    // Returns the number of entries parsed
+    static int parse(const ByteView &bytes, QVector<MountEntry> &out);
+
+    // Decode the \ooo escapes of a device or mount point
+    static QString decodePath(const ByteView &field);
+
+    // Block-device backed, network or FUSE filesystem - skips proc, sysfs,
+    // tmpfs, cgroup, overlay and the other pseudo filesystems
+    static bool isRealFilesystem(const MountEntry &entry);
+};
+
+#endif // MOUNTPARSER_H
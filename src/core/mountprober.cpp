@@ -0,0 +1,272 @@
+#include "mountprober.h"
+#include <QSet>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <sys/statvfs.h>
+#include <time.h>
+
+struct MountProber::SharedState {
+    struct Job {
+        quint64 ticket;
+        QByteArray path;
+        bool first;                 // Mount has never answered
+    };
+
+    std::mutex mutex;
+    std::condition_variable jobReady;
+
+    std::deque<Job> jobs;
+    std::unordered_map<quint64, MountProbe> results;
+    std::unordered_map<quint64, qint64> started;    // Running probes: ticket -> start ms
+    std::unordered_set<quint64> abandoned;          // Mount went away while probing
+    quint64 nextTicket = 1;
+    int threads = 0;                // Alive, hung ones included
+    int targetThreads = 0;          // Workers above this leave when idle
+    bool stopping = false;
+
+    ProbeFunction probeFunction;
+    std::function<void()> firstResult;
+};
+
+MountProber::MountProber(int workers, int maxThreads, int deadlineMs, int maxBackoffMs,
+                         const ProbeFunction &probeFunction)
+    : m_state(std::make_shared<SharedState>())
+    , m_workers(qMax(1, workers))
+    , m_maxThreads(qMax(m_workers, maxThreads))
+    , m_deadlineMs(deadlineMs)
+    , m_maxBackoffMs(maxBackoffMs)
+{
+    m_state->probeFunction = probeFunction ? probeFunction : ProbeFunction(statPath);
+    m_state->targetThreads = m_workers;
+
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    for (int i = 0; i < m_workers; ++i) {
+        std::thread(workerLoop, m_state).detach();
+        ++m_state->threads;
+    }
+}
+
+MountProber::~MountProber()
+{
+    // Idle workers exit now, hung ones when their statvfs finally returns.
+    // The shared state lives until the last of them is gone.
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    m_state->stopping = true;
+    m_state->jobs.clear();
+    m_state->firstResult = nullptr;
+    m_state->jobReady.notify_all();
+}
+
+MountProbe MountProber::statPath(const QByteArray &path)
+{
+    MountProbe probe;
+
+    struct statvfs st;
+    if (::statvfs(path.constData(), &st) != 0) {
+        return probe;
+    }
+
+    const qint64 blockSize = st.f_frsize ? qint64(st.f_frsize) : qint64(st.f_bsize);
+    probe.totalBytes = qint64(st.f_blocks) * blockSize;
+    probe.availableBytes = qint64(st.f_bavail) * blockSize;
+    probe.usedBytes = probe.totalBytes - qint64(st.f_bfree) * blockSize;
+    probe.ok = true;
+
+    return probe;
+}
+
+void MountProber::setFirstResultCallback(const std::function<void()> &callback)
+{
+    // Taking the lock also waits out a callback that is running right now
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    m_state->firstResult = callback;
+}
+
+void MountProber::workerLoop(std::shared_ptr<SharedState> state)
+{
+    std::unique_lock<std::mutex> lock(state->mutex);
+
+    for (;;) {
+        state->jobReady.wait(lock, [&state]() {
+            return state->stopping || state->threads > state->targetThreads || !state->jobs.empty();
+        });
+
+        // Shutting down, or a hung worker came back and the pool is too large
+        if (state->stopping || state->threads > state->targetThreads) {
+            --state->threads;
+            return;
+        }
+
+        SharedState::Job job = state->jobs.front();
+        state->jobs.pop_front();
+        state->started[job.ticket] = nowMs();
+
+        // The only place that may block for minutes
+        lock.unlock();
+        MountProbe probe = state->probeFunction(job.path);
+        lock.lock();
+
+        state->started.erase(job.ticket);
+        if (state->abandoned.erase(job.ticket) == 0) {
+            state->results[job.ticket] = probe;
+            if (job.first && state->firstResult) {
+                state->firstResult();
+            }
+        }
+    }
+}
+
+qint64 MountProber::nowMs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return qint64(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+void MountProber::probe(const QVector<QByteArray> &paths, QVector<MountProbe> &results)
+{
+    SharedState &state = *m_state;
+    const qint64 now = nowMs();
+    const int count = paths.size();
+
+    if (results.size() != count) {
+        results.resize(count);
+    }
+
+    QSet<QByteArray> current;
+    current.reserve(count);
+    for (const QByteArray &path : paths) {
+        current.insert(path);
+    }
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    // Forget mounts that went away: drop their answer or queued job, and
+    // leave a running probe for the worker to drop when it returns
+    for (auto it = m_health.begin(); it != m_health.end();) {
+        if (current.contains(it.key())) {
+            ++it;
+            continue;
+        }
+
+        const quint64 ticket = it->ticket;
+        if (ticket && state.results.erase(ticket) == 0) {
+            if (state.started.count(ticket) > 0) {
+                state.abandoned.insert(ticket);
+            }
+            else {
+                for (auto job = state.jobs.begin(); job != state.jobs.end(); ++job) {
+                    if (job->ticket == ticket) {
+                        state.jobs.erase(job);
+                        break;
+                    }
+                }
+            }
+        }
+        it = m_health.erase(it);
+    }
+
+    // Take what has answered, judge what has not - never wait
+    bool submitted = false;
+    for (int i = 0; i < count; ++i) {
+        const QByteArray &path = paths.at(i);
+        MountHealth &health = m_health[path];
+
+        if (health.ticket) {
+            auto found = state.results.find(health.ticket);
+            auto started = state.started.find(health.ticket);
+
+            if (found != state.results.end()) {
+                // In time: healthy again. Late: fresh values, backoff stays.
+                if (!health.hung) {
+                    health.misses = 0;
+                    health.retryMs = 0;
+                }
+                health.hung = false;
+                health.answered = true;
+                health.last = found->second;
+                health.ticket = 0;
+                state.results.erase(found);
+            }
+            else if (started != state.started.end()) {
+                if (!health.hung && now - started->second >= m_deadlineMs) {
+                    // First miss of this probe - quarantine with exponential backoff
+                    ++health.misses;
+                    qint64 backoff = qint64(m_deadlineMs) << qMin(health.misses + 2, 20);
+                    health.retryMs = started->second + qMin<qint64>(backoff, m_maxBackoffMs);
+                    health.hung = true;
+                    health.last.stale = true;
+                }
+            }
+            else if (now - health.submittedMs >= m_deadlineMs) {
+                // Still queued behind busy workers: the values are old, but
+                // the mount itself is not to blame
+                health.last.stale = true;
+            }
+        }
+
+        // Next probe for every mount that is neither busy nor backing off
+        if (health.ticket == 0 && now >= health.retryMs) {
+            health.ticket = state.nextTicket++;
+            health.submittedMs = now;
+            state.jobs.push_back({health.ticket, path, !health.answered});
+            submitted = true;
+        }
+
+        results[i] = health.last;
+    }
+
+    replaceHungWorkers(now);
+
+    if (submitted) {
+        state.jobReady.notify_all();
+    }
+}
+
+void MountProber::replaceHungWorkers(qint64 now)
+{
+    SharedState &state = *m_state;
+
+    int hung = 0;
+    for (const auto &entry : state.started) {
+        if (now - entry.second >= m_deadlineMs) {
+            ++hung;
+        }
+    }
+
+    // Keep m_workers threads free for the healthy mounts. Once a hung probe
+    // returns the target drops again and the surplus leaves.
+    const int target = m_workers + hung;
+    if (target < state.targetThreads) {
+        state.jobReady.notify_all();
+    }
+    state.targetThreads = target;
+
+    while (state.threads < qMin(target, m_maxThreads)) {
+        std::thread(workerLoop, m_state).detach();
+        ++state.threads;
+    }
+}
+
+int MountProber::quarantinedCount() const
+{
+    const qint64 now = nowMs();
+    int count = 0;
+    for (const MountHealth &health : m_health) {
+        if (health.hung || health.retryMs > now) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+int MountProber::threadCount() const
+{
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    return m_state->threads;
+}
@@ -0,0 +1,91 @@
+#ifndef MOUNTPROBER_H
+#define MOUNTPROBER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QVector>
+#include <functional>
+#include <memory>
+
+// Result of one statvfs() for a mount
+struct MountProbe {
+    bool ok = false;            // statvfs answered without error
+    bool stale = false;         // Not answered in time - values are from an older probe
+    qint64 totalBytes = 0;
+    qint64 usedBytes = 0;
+    qint64 availableBytes = 0;
+};
+
+// Hang-proof filesystem usage probing. statvfs() on a dead NFS or FUSE mount
+// can block for minutes in uninterruptible sleep, so probes run on a small
+// set of worker threads and probe() never waits for them: it hands out what
+// has answered so far and queues the next round.
+//
+// The deadline runs from the moment a worker picks a probe up, so mounts
+// queued behind a hung one are not blamed for it. A mount whose probe runs
+// past the deadline is reported stale and quarantined: no new probe until
+// the hung one returns and an exponential backoff expired. Its worker is
+// replaced so healthy mounts keep their full pool, up to maxThreads in total.
+//
+// Workers are detached std::threads sharing state with the prober - a
+// QThreadPool would block our destructor (and application exit) on a probe
+// that never returns.
+class MountProber
+{
+public:
+    // Runs on a worker thread; statvfs() unless replaced (tests)
+    typedef std::function<MountProbe(const QByteArray &path)> ProbeFunction;
+
+    MountProber(int workers, int maxThreads, int deadlineMs, int maxBackoffMs,
+                const ProbeFunction &probeFunction = ProbeFunction());
+    ~MountProber();
+
+    // Probe every path; results[i] belongs to paths[i]. Never blocks: a
+    // mount's values are those of its newest probe that answered, and a
+    // new mount has none until its first probe does.
+    void probe(const QVector<QByteArray> &paths, QVector<MountProbe> &results);
+
+    // Called on a worker thread, under the prober's lock, when a mount's
+    // first probe answered - lets the caller collect again instead of
+    // waiting a full interval. Must not block or call back into the prober.
+    void setFirstResultCallback(const std::function<void()> &callback);
+
+    // Mounts currently quarantined (hung probe or backing off)
+    int quarantinedCount() const;
+
+    // Worker threads alive, hung ones included
+    int threadCount() const;
+
+    static MountProbe statPath(const QByteArray &path);
+
+private:
+    struct SharedState;
+
+    // Per-mount bookkeeping, caller thread only
+    struct MountHealth {
+        quint64 ticket = 0;         // Outstanding probe, 0 if none
+        qint64 submittedMs = 0;
+        qint64 retryMs = 0;         // No new probe before this time
+        int misses = 0;             // Consecutive missed deadlines
+        bool hung = false;          // Outstanding probe ran past the deadline
+        bool answered = false;      // Some probe has answered
+        MountProbe last;
+    };
+
+    static void workerLoop(std::shared_ptr<SharedState> state);
+    static qint64 nowMs();
+    void replaceHungWorkers(qint64 now);
+
+    std::shared_ptr<SharedState> m_state;
+    QHash<QByteArray, MountHealth> m_health;
+    int m_workers;
+    int m_maxThreads;
+    int m_deadlineMs;
+    int m_maxBackoffMs;
+
+    // Disable copy constructor/assignment - owns worker threads
+    MountProber(const MountProber &) = delete;
+    MountProber &operator=(const MountProber &) = delete;
+};
+
+#endif // MOUNTPROBER_H
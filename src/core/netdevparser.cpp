@@ -0,0 +1,92 @@
+#include "netdevparser.h"
+#include <cstring>
+
+namespace {
+    inline quint64 parseNumber(const char *&p, const char *end)
+    {
+        while (p < end && *p == ' ') {
+            ++p;
+        }
+
+        quint64 result = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            result = result * 10 + quint64(*p - '0');
+            ++p;
+        }
+
+        return result;
+    }
+
+    // Count interface lines (those with a ':') to size the table up front
+    int countInterfaces(const char *p, const char *end)
+    {
+        int count = 0;
+        while (p < end) {
+            const char *lineEnd = static_cast<const char *>(std::memchr(p, '\n', end - p));
+            if (!lineEnd) {
+                lineEnd = end;
+            }
+            if (std::memchr(p, ':', lineEnd - p)) {
+                ++count;
+            }
+            p = lineEnd + 1;
+        }
+        return count;
+    }
+}
+
+int NetDevParser::parse(const ByteView &bytes, QVector<InterfaceCounters> &out)
+{
+    const char *p = bytes.begin();
+    const char *end = bytes.end();
+
+    const int count = countInterfaces(p, end);
+    if (out.size() != count) {
+        out.resize(count);
+    }
+
+    // Format (two header lines, then one line per interface):
+    // "  eth0: rx_bytes rx_packets rx_errs rx_drop fifo frame compressed multicast
+    //          tx_bytes tx_packets tx_errs tx_drop fifo colls carrier compressed"
+    InterfaceCounters *entry = out.data();
+    int index = 0;
+
+    while (p < end && index < count) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+
+        const char *colon = static_cast<const char *>(std::memchr(p, ':', lineEnd - p));
+        if (colon) {
+            const char *nameStart = p;
+            while (nameStart < colon && *nameStart == ' ') {
+                ++nameStart;
+            }
+
+            InterfaceCounters &counters = entry[index++];
+            size_t nameLength = qMin<size_t>(colon - nameStart, sizeof(counters.name) - 1);
+            std::memcpy(counters.name, nameStart, nameLength);
+            counters.name[nameLength] = '\0';
+
+            const char *q = colon + 1;
+            quint64 fields[16];
+            for (quint64 &field : fields) {
+                field = parseNumber(q, lineEnd);
+            }
+
+            counters.rxBytes = fields[0];
+            counters.rxPackets = fields[1];
+            counters.rxErrors = fields[2];
+            counters.rxDropped = fields[3];
+            counters.txBytes = fields[8];
+            counters.txPackets = fields[9];
+            counters.txErrors = fields[10];
+            counters.txDropped = fields[11];
+        }
+
+        p = lineEnd + 1;
+    }
+
+    return index;
+}
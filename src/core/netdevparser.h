@@ -0,0 +1,37 @@
+#ifndef NETDEVPARSER_H
+#define NETDEVPARSER_H
+
+#include <QtGlobal>
+#include <QVector>
+#include "byteview.h"
+
+// Raw counters of one /proc/net/dev line
+struct InterfaceCounters {
+    char name[16] = {};         // IFNAMSIZ, NUL-terminated
+    quint64 rxBytes = 0;
+    quint64 rxPackets = 0;
+    quint64 rxErrors = 0;
+    quint64 rxDropped = 0;
+    quint64 txBytes = 0;
+    quint64 txPackets = 0;
+    quint64 txErrors = 0;
+    quint64 txDropped = 0;
+};
+
+// Single-pass /proc/net/dev parser. Fills one flat entry per interface in
+// file order; the vector only reallocates when the interface count changes.
+class NetDevParser
+{
+public:
+    // Returns the number of interfaces parsed
+    static int parse(const ByteView &bytes, QVector<InterfaceCounters> &out);
+
+    // Counter delta. The kernel keeps these counters in 64 bits, so a value
+    // going backwards was reset (interface recreated under the same name,
+    // driver reset) - everything counted since then is the current value.
+    static quint64 counterDelta(quint64 current, quint64 previous) {
+        return current >= previous ? current - previous : current;
+    }
+};
+
+#endif // NETDEVPARSER_H
@@ -0,0 +1,268 @@
+#include "netlinkstats.h"
+#include <QDebug>
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/if_link.h>
+
+namespace {
+    const int RECEIVE_BUFFER_SIZE = 32 * 1024;  // Holds many links per recv()
+
+    struct LinkDumpRequest {
+        nlmsghdr header;
+        ifinfomsg info;
+    };
+
+    struct StatsDumpRequest {
+        nlmsghdr header;
+        if_stats_msg info;
+    };
+
+    void fillCounters(InterfaceCounters &counters, const rtnl_link_stats64 &stats)
+    {
+        counters.rxBytes = stats.rx_bytes;
+        counters.rxPackets = stats.rx_packets;
+        counters.rxErrors = stats.rx_errors;
+        counters.rxDropped = stats.rx_dropped;
+        counters.txBytes = stats.tx_bytes;
+        counters.txPackets = stats.tx_packets;
+        counters.txErrors = stats.tx_errors;
+        counters.txDropped = stats.tx_dropped;
+    }
+}
+
+NetlinkStats::NetlinkStats()
+{
+}
+
+NetlinkStats::~NetlinkStats()
+{
+    close();
+}
+
+bool NetlinkStats::open()
+{
+    if (m_fd >= 0) {
+        return true;    // Already open
+    }
+
+    m_fd = ::socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (m_fd < 0) {
+        qDebug() << "Cannot open rtnetlink socket:" << std::strerror(errno);
+        return false;
+    }
+
+    sockaddr_nl local;
+    std::memset(&local, 0, sizeof(local));
+    local.nl_family = AF_NETLINK;
+    if (::bind(m_fd, reinterpret_cast<sockaddr *>(&local), sizeof(local)) < 0) {
+        qDebug() << "Cannot bind rtnetlink socket:" << std::strerror(errno);
+        close();
+        return false;
+    }
+
+    if (m_buffer.isEmpty()) {
+        m_buffer.resize(RECEIVE_BUFFER_SIZE);
+    }
+
+    return true;
+}
+
+void NetlinkStats::close()
+{
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+int NetlinkStats::dump(nlmsghdr *request, const std::function<void(const nlmsghdr *)> &handle)
+{
+    request->nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request->nlmsg_seq = ++m_sequence;
+
+    if (::send(m_fd, request, request->nlmsg_len, 0) < 0) {
+        const int error = errno;
+        qDebug() << "rtnetlink dump request failed:" << std::strerror(error);
+        close();
+        return -error;
+    }
+
+    for (;;) {
+        ssize_t received = ::recv(m_fd, m_buffer.data(), m_buffer.size(), 0);
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            const int error = errno;
+            qDebug() << "rtnetlink receive failed:" << std::strerror(error);
+            close();
+            return -error;
+        }
+
+        int remaining = int(received);
+        for (const nlmsghdr *message = reinterpret_cast<const nlmsghdr *>(m_buffer.constData());
+             NLMSG_OK(message, remaining);
+             message = NLMSG_NEXT(message, remaining)) {
+
+            if (message->nlmsg_seq != m_sequence) {
+                continue;   // Stale reply from an aborted dump
+            }
+
+            if (message->nlmsg_type == NLMSG_DONE) {
+                return 0;
+            }
+
+            if (message->nlmsg_type == NLMSG_ERROR) {
+                const nlmsgerr *error = static_cast<const nlmsgerr *>(NLMSG_DATA(message));
+                return error->error < 0 ? error->error : -EPROTO;
+            }
+
+            handle(message);
+        }
+    }
+}
+
+bool NetlinkStats::readLinks(QVector<InterfaceCounters> &out)
+{
+    LinkDumpRequest request;
+    std::memset(&request, 0, sizeof(request));
+    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(ifinfomsg));
+    request.header.nlmsg_type = RTM_GETLINK;
+    request.info.ifi_family = AF_UNSPEC;
+
+    int count = 0;
+    m_names.clear();
+
+    const int result = dump(&request.header, [this, &out, &count](const nlmsghdr *message) {
+        if (message->nlmsg_type != RTM_NEWLINK) {
+            return;
+        }
+
+        if (count >= out.size()) {
+            out.resize(qMax(16, out.size() * 2));
+        }
+        InterfaceCounters &counters = out[count];
+        counters = InterfaceCounters();
+        bool haveStats = false;
+
+        const ifinfomsg *info = static_cast<const ifinfomsg *>(NLMSG_DATA(message));
+        int attributeLength = int(IFLA_PAYLOAD(message));
+        for (const rtattr *attribute = IFLA_RTA(info);
+             RTA_OK(attribute, attributeLength);
+             attribute = RTA_NEXT(attribute, attributeLength)) {
+
+            if (attribute->rta_type == IFLA_IFNAME) {
+                size_t length = qMin<size_t>(RTA_PAYLOAD(attribute), sizeof(counters.name) - 1);
+                std::memcpy(counters.name, RTA_DATA(attribute), length);
+                counters.name[length] = '\0';
+            }
+            else if (attribute->rta_type == IFLA_STATS64
+                     && RTA_PAYLOAD(attribute) >= sizeof(rtnl_link_stats64)) {
+                // May be unaligned for 64-bit loads - copy out first
+                rtnl_link_stats64 stats;
+                std::memcpy(&stats, RTA_DATA(attribute), sizeof(stats));
+                fillCounters(counters, stats);
+                haveStats = true;
+            }
+        }
+
+        if (haveStats && counters.name[0] != '\0') {
+            m_names.insert(info->ifi_index, QByteArray(counters.name));
+            ++count;
+        }
+    });
+
+    if (result < 0) {
+        qDebug() << "rtnetlink link dump failed:" << std::strerror(-result);
+        return false;
+    }
+
+    out.resize(count);
+    m_namesValid = true;
+    return true;
+}
+
+int NetlinkStats::readStats(QVector<InterfaceCounters> &out, bool &unknownLink)
+{
+    StatsDumpRequest request;
+    std::memset(&request, 0, sizeof(request));
+    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(if_stats_msg));
+    request.header.nlmsg_type = RTM_GETSTATS;
+    request.info.family = AF_UNSPEC;
+    request.info.filter_mask = IFLA_STATS_FILTER_BIT(IFLA_STATS_LINK_64);
+
+    int count = 0;
+    unknownLink = false;
+
+    const int result = dump(&request.header, [this, &out, &count, &unknownLink](const nlmsghdr *message) {
+        if (message->nlmsg_type != RTM_NEWSTATS || unknownLink) {
+            return;
+        }
+
+        const if_stats_msg *info = static_cast<const if_stats_msg *>(NLMSG_DATA(message));
+        const auto name = m_names.constFind(int(info->ifindex));
+        if (name == m_names.constEnd()) {
+            unknownLink = true;     // Created since the names were read
+            return;
+        }
+
+        const rtattr *attribute = reinterpret_cast<const rtattr *>(
+            reinterpret_cast<const char *>(info) + NLMSG_ALIGN(sizeof(if_stats_msg)));
+        int attributeLength = int(message->nlmsg_len) - int(NLMSG_LENGTH(sizeof(if_stats_msg)));
+        for (; RTA_OK(attribute, attributeLength); attribute = RTA_NEXT(attribute, attributeLength)) {
+            if (attribute->rta_type != IFLA_STATS_LINK_64 || RTA_PAYLOAD(attribute) < sizeof(rtnl_link_stats64)) {
+                continue;
+            }
+
+            if (count >= out.size()) {
+                out.resize(qMax(16, out.size() * 2));
+            }
+            InterfaceCounters &counters = out[count++];
+            counters = InterfaceCounters();
+            std::memcpy(counters.name, name->constData(), size_t(name->size()) + 1);
+
+            rtnl_link_stats64 stats;
+            std::memcpy(&stats, RTA_DATA(attribute), sizeof(stats));
+            fillCounters(counters, stats);
+            break;
+        }
+    });
+
+    if (result == 0) {
+        out.resize(count);
+    }
+    return result;
+}
+
+bool NetlinkStats::readAll(QVector<InterfaceCounters> &out)
+{
+    if (!open()) {
+        return false;
+    }
+
+    // The link dump also carries the counters - no second request needed
+    if (!m_useStats || !m_namesValid) {
+        return readLinks(out);
+    }
+
+    bool unknownLink = false;
+    const int result = readStats(out, unknownLink);
+    if (result == 0 && !unknownLink) {
+        return true;
+    }
+
+    if (result < 0) {
+        if (!isOpen()) {
+            return false;   // Socket failed, not the request
+        }
+        qDebug() << "RTM_GETSTATS unavailable (" << std::strerror(-result)
+                 << ") - dumping full links instead";
+        m_useStats = false;
+    }
+    return readLinks(out);
+}
@@ -0,0 +1,60 @@
+#ifndef NETLINKSTATS_H
+#define NETLINKSTATS_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QVector>
+#include <functional>
+#include "netdevparser.h"
+
+struct nlmsghdr;
+
+// rtnetlink interface counter backend. Counters come from an RTM_GETSTATS
+// dump filtered to IFLA_STATS_LINK_64 - a bare ifindex + rtnl_link_stats64
+// per link, several times cheaper than /proc/net/dev. Names are not
+// part of that reply: a full RTM_GETLINK dump (names and IFLA_STATS64)
+// fills the ifindex -> name map on the first call, whenever an unknown
+// ifindex shows up and after invalidateNames(). Kernels without
+// RTM_GETSTATS (< 4.7) use the RTM_GETLINK dump every call.
+class NetlinkStats
+{
+public:
+    NetlinkStats();
+    ~NetlinkStats();
+
+    // Opens the NETLINK_ROUTE socket if needed
+    bool open();
+    void close();
+
+    bool isOpen() const {
+        return m_fd >= 0;
+    }
+
+    // Fill `out` with one entry per link in ifindex order. Returns false if
+    // the socket is unavailable or the dump failed - callers fall back to /proc.
+    bool readAll(QVector<InterfaceCounters> &out);
+
+    // Links may have been renamed - reload the names on the next readAll()
+    void invalidateNames() {
+        m_namesValid = false;
+    }
+
+private:
+    // Sends a dump request and hands every reply to handle(); 0 or -errno
+    int dump(nlmsghdr *request, const std::function<void(const nlmsghdr *)> &handle);
+    bool readLinks(QVector<InterfaceCounters> &out);
+    int readStats(QVector<InterfaceCounters> &out, bool &unknownLink);
+
+    int m_fd = -1;
+    quint32 m_sequence = 0;
+    QByteArray m_buffer;                // Reused receive buffer
+    QHash<int, QByteArray> m_names;     // ifindex -> name
+    bool m_namesValid = false;
+    bool m_useStats = true;             // RTM_GETSTATS supported
+
+    // Disable copy constructor/assignment - owns a descriptor
+    NetlinkStats(const NetlinkStats &) = delete;
+    NetlinkStats &operator=(const NetlinkStats &) = delete;
+};
+
+#endif // NETLINKSTATS_H
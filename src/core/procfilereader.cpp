@@ -0,0 +1,104 @@
+#include "procfilereader.h"
+#include <QDebug>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+    const int INITIAL_BUFFER_SIZE = 4096;   // One page covers most sysfs/proc files
+}
+
+ProcFileReader::ProcFileReader(const QString &path)
+    : m_path(path)
+{
+}
+
+ProcFileReader::~ProcFileReader()
+{
+    close();
+}
+
+bool ProcFileReader::open()
+{
+    if (m_fd >= 0) {
+        return true;    // Already open
+    }
+
+    if (m_path.isEmpty()) {
+        return false;
+    }
+
+    m_fd = ::open(m_path.toLocal8Bit().constData(), O_RDONLY | O_CLOEXEC);
+    if (m_fd < 0) {
+        return false;
+    }
+
+    if (m_buffer.isEmpty()) {
+        m_buffer.resize(INITIAL_BUFFER_SIZE);
+    }
+
+    return true;
+}
+
+void ProcFileReader::close()
+{
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    m_size = 0;
+}
+
+void ProcFileReader::setPath(const QString &path)
+{
+    if (path == m_path) {
+        return;
+    }
+
+    close();
+    m_path = path;
+}
+
+ByteView ProcFileReader::read()
+{
+    ByteView view;
+
+    if (!open()) {
+        return view;
+    }
+
+    // A short read is not EOF: seq_file sources (/proc/net/dev, diskstats,
+    // ...) return one page of records per call however large the buffer.
+    // Read until pread() returns 0, doubling the buffer whenever it fills -
+    // a steady-state read of a small file is two pread() calls.
+    qint64 total = 0;
+    for (;;) {
+        if (total == m_buffer.size()) {
+            m_buffer.resize(m_buffer.size() * 2);
+        }
+
+        qint64 space = m_buffer.size() - total;
+        ssize_t n = ::pread(m_fd, m_buffer.data() + total, space, total);
+
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            qDebug() << "Cannot read file" << m_path;
+            close();    // Device may have gone away - reopen on next read
+            return view;
+        }
+
+        if (n == 0) {
+            break;
+        }
+        total += n;
+    }
+
+    m_size = int(total);
+    view.data = m_buffer.constData();
+    view.size = m_size;
+
+    return view;
+}
@@ -0,0 +1,54 @@
+#ifndef PROCFILEREADER_H
+#define PROCFILEREADER_H
+
+#include <QByteArray>
+#include <QString>
+#include "byteview.h"
+
+// Keeps one descriptor open on a /proc or /sys file and re-reads it with
+// pread() at offset 0 into a reusable buffer. Replaces the per-tick
+// QFile open/QTextStream/close cycle of SystemUtils::readFile().
+class ProcFileReader
+{
+public:
+    explicit ProcFileReader(const QString &path = QString());
+    ~ProcFileReader();
+
+    // Opens the file if needed - cheap when already open
+    bool open();
+    void close();
+
+    bool isOpen() const {
+        return m_fd >= 0;
+    }
+
+    // For poll() on files that signal changes (e.g. /proc/self/mounts)
+    int fd() const {
+        return m_fd;
+    }
+
+    QString path() const {
+        return m_path;
+    }
+    void setPath(const QString &path);
+
+    // Re-read from offset 0. The view stays valid until the next read()/close()
+    ByteView read();
+
+    // Number of bytes in the last successful read
+    int lastSize() const {
+        return m_size;
+    }
+
+private:
+    QString m_path;
+    int m_fd = -1;
+    QByteArray m_buffer;    // Grows to fit the largest read, never shrinks
+    int m_size = 0;
+
+    // Disable copy constructor/assignment - owns a descriptor
+    ProcFileReader(const ProcFileReader &) = delete;
+    ProcFileReader &operator=(const ProcFileReader &) = delete;
+};
+
+#endif // PROCFILEREADER_H
@@ -0,0 +1,143 @@
+#include "procpidparser.h"
+#include <cstring>
+
+namespace {
+    // Parse a signed decimal, skipping leading blanks. Advances p.
+    inline bool parseNumber(const char *&p, const char *end, qint64 &value)
+    {
+        while (p < end && *p == ' ') {
+            ++p;
+        }
+
+        bool negative = false;
+        if (p < end && *p == '-') {
+            negative = true;
+            ++p;
+        }
+
+        const char *digits = p;
+        qint64 result = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            result = result * 10 + (*p - '0');
+            ++p;
+        }
+
+        if (p == digits) {
+            return false;
+        }
+
+        value = negative ? -result : result;
+        return true;
+    }
+}
+
+bool ProcPidParser::parseStat(const ByteView &bytes, PidStat &out)
+{
+    // Failed read - memchr() must not see its null data
+    if (bytes.isEmpty()) {
+        return false;
+    }
+
+    const char *p = bytes.begin();
+    const char *end = bytes.end();
+
+    // Format: "pid (comm) state ppid ..." - comm may contain spaces and
+    // parentheses, so it ends at the last ')'
+    const char *open = static_cast<const char *>(std::memchr(p, '(', end - p));
+    const char *close = end;
+    while (close > p && close[-1] != ')') {
+        --close;
+    }
+    if (!open || close <= open + 1) {
+        return false;
+    }
+    --close;
+
+    int length = qMin(int(close - open - 1), int(sizeof(out.comm)) - 1);
+    std::memcpy(out.comm, open + 1, length);
+    out.comm[length] = '\0';
+
+    p = close + 1;
+    while (p < end && *p == ' ') {
+        ++p;
+    }
+    if (p >= end) {
+        return false;
+    }
+    out.state = *p++;
+
+    // Remaining fields are numbered from 4 (ppid) as in proc(5)
+    const int LAST_FIELD = 24;     // rss
+    int field = 4;
+    qint64 value = 0;
+    for (; field <= LAST_FIELD && parseNumber(p, end, value); ++field) {
+        switch (field) {
+        case 4:  out.ppid = int(value); break;
+        case 14: out.utime = quint64(value); break;
+        case 15: out.stime = quint64(value); break;
+        case 19: out.nice = int(value); break;
+        case 20: out.numThreads = int(value); break;
+        case 22: out.startTime = quint64(value); break;
+        case 23: out.virtualSize = quint64(value); break;
+        case 24: out.rssPages = value; break;
+        default: break;
+        }
+    }
+
+    return field > LAST_FIELD;
+}
+
+bool ProcPidParser::parseStatm(const ByteView &bytes, PidStatm &out)
+{
+    const char *p = bytes.begin();
+    const char *end = bytes.end();
+
+    qint64 size = 0;
+    qint64 resident = 0;
+    qint64 shared = 0;
+    if (!parseNumber(p, end, size) || !parseNumber(p, end, resident) ||
+        !parseNumber(p, end, shared)) {
+        return false;
+    }
+
+    out.size = quint64(size);
+    out.resident = quint64(resident);
+    out.shared = quint64(shared);
+    return true;
+}
+
+bool ProcPidParser::parseIo(const ByteView &bytes, PidIo &out)
+{
+    const char *p = bytes.begin();
+    const char *end = bytes.end();
+
+    // Format: "read_bytes: 4096" - only two of the seven lines are used
+    int found = 0;
+    while (p < end) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+
+        quint64 *field = nullptr;
+        const char *q = p;
+        if (lineEnd - p > 11 && std::memcmp(p, "read_bytes:", 11) == 0) {
+            field = &out.readBytes;
+            q += 11;
+        }
+        else if (lineEnd - p > 12 && std::memcmp(p, "write_bytes:", 12) == 0) {
+            field = &out.writeBytes;
+            q += 12;
+        }
+
+        qint64 value = 0;
+        if (field && parseNumber(q, lineEnd, value)) {
+            *field = quint64(value);
+            ++found;
+        }
+
+        p = lineEnd + 1;
+    }
+
+    return found == 2;
+}
@@ -0,0 +1,43 @@
+#ifndef PROCPIDPARSER_H
+#define PROCPIDPARSER_H
+
+#include <QtGlobal>
+#include "byteview.h"
+
+// Fields of /proc/[pid]/stat used by the process monitor
+struct PidStat {
+    char comm[32] = {};         // TASK_COMM_LEN is 16, kernel threads up to 64 - truncated
+    char state = '?';           // R, S, D, Z, T, ...
+    int ppid = 0;
+    quint64 utime = 0;          // Clock ticks
+    quint64 stime = 0;          // Clock ticks
+    int nice = 0;
+    int numThreads = 0;
+    quint64 startTime = 0;      // Clock ticks after boot - (pid, startTime) is unique
+    quint64 virtualSize = 0;    // Bytes
+    qint64 rssPages = 0;
+};
+
+// /proc/[pid]/statm, all in pages
+struct PidStatm {
+    quint64 size = 0;
+    quint64 resident = 0;
+    quint64 shared = 0;
+};
+
+// Storage I/O of /proc/[pid]/io (readable for own processes or as root)
+struct PidIo {
+    quint64 readBytes = 0;      // Fetched from the block layer
+    quint64 writeBytes = 0;     // Sent to the block layer
+};
+
+// Allocation-free parsers for the per-process /proc files
+class ProcPidParser
+{
+public:
+    static bool parseStat(const ByteView &bytes, PidStat &out);
+    static bool parseStatm(const ByteView &bytes, PidStatm &out);
+    static bool parseIo(const ByteView &bytes, PidIo &out);
+};
+
+#endif // PROCPIDPARSER_H
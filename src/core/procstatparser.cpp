@@ -0,0 +1,141 @@
+#include "procstatparser.h"
+#include <cstring>
+
+namespace {
+    // Parse an unsigned decimal, skipping leading blanks. Advances p.
+    inline bool parseNumber(const char *&p, const char *end, quint64 &value)
+    {
+        while (p < end && *p == ' ') {
+            ++p;
+        }
+
+        const char *digits = p;
+        quint64 result = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            result = result * 10 + quint64(*p - '0');
+            ++p;
+        }
+
+        if (p == digits) {
+            return false;
+        }
+
+        value = result;
+        return true;
+    }
+
+    // True if [p, end) begins with the given keyword followed by a blank
+    inline bool matchKey(const char *p, const char *end, const char *key, int keyLength)
+    {
+        return end - p > keyLength
+               && std::memcmp(p, key, keyLength) == 0
+               && p[keyLength] == ' ';
+    }
+}
+
+int ProcStatParser::parseCpuTimes(const char *p, const char *end, CpuTimes &out)
+{
+    quint64 *fields[] = {
+        &out.user, &out.nice, &out.system, &out.idle, &out.iowait,
+        &out.irq, &out.softirq, &out.steal, &out.guest, &out.guestNice
+    };
+
+    int count = 0;
+    for (quint64 *field : fields) {
+        if (!parseNumber(p, end, *field)) {
+            break;
+        }
+        ++count;
+    }
+
+    // Older kernels report fewer columns - clear the rest
+    for (int i = count; i < 10; ++i) {
+        *fields[i] = 0;
+    }
+
+    return count;
+}
+
+bool ProcStatParser::parse(const ByteView &bytes, ProcStatData &out,
+                           quint64 *coreTotal, quint64 *coreIdle, int coreCapacity)
+{
+    const char *p = bytes.begin();
+    const char *end = bytes.end();
+
+    bool haveCpu = false;
+    out.coreCount = 0;
+
+    while (p < end) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+
+        quint64 value = 0;
+        const char *q = p;
+
+        // Dispatch on the first byte so the long intr/softirq lines are skipped
+        // with a single memchr
+        switch (*p) {
+        case 'c':
+            if (matchKey(p, lineEnd, "cpu", 3)) {
+                haveCpu = parseCpuTimes(p + 3, lineEnd, out.cpu) >= 4;
+            }
+            else if (lineEnd - p > 3 && std::memcmp(p, "cpu", 3) == 0 && p[3] >= '0' && p[3] <= '9') {
+                q += 3;
+                if (parseNumber(q, lineEnd, value)) {
+                    int index = int(value);
+                    out.coreCount = qMax(out.coreCount, index + 1);
+
+                    if (index < coreCapacity) {
+                        CpuTimes core;
+                        parseCpuTimes(q, lineEnd, core);
+                        coreTotal[index] = core.total();
+                        coreIdle[index] = core.idleTotal();
+                    }
+                }
+            }
+            else if (matchKey(p, lineEnd, "ctxt", 4)) {
+                q += 4;
+                if (parseNumber(q, lineEnd, value)) {
+                    out.contextSwitches = value;
+                }
+            }
+            break;
+        case 'b':
+            if (matchKey(p, lineEnd, "btime", 5)) {
+                q += 5;
+                if (parseNumber(q, lineEnd, value)) {
+                    out.bootTime = qint64(value);
+                }
+            }
+            break;
+        case 'p':
+            if (matchKey(p, lineEnd, "processes", 9)) {
+                q += 9;
+                if (parseNumber(q, lineEnd, value)) {
+                    out.processes = value;
+                }
+            }
+            else if (matchKey(p, lineEnd, "procs_running", 13)) {
+                q += 13;
+                if (parseNumber(q, lineEnd, value)) {
+                    out.procsRunning = int(value);
+                }
+            }
+            else if (matchKey(p, lineEnd, "procs_blocked", 13)) {
+                q += 13;
+                if (parseNumber(q, lineEnd, value)) {
+                    out.procsBlocked = int(value);
+                }
+            }
+            break;
+        default:
+            break;  // intr, softirq - not tracked
+        }
+
+        p = lineEnd + 1;
+    }
+
+    return haveCpu;
+}
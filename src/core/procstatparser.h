@@ -0,0 +1,56 @@
+#ifndef PROCSTATPARSER_H
+#define PROCSTATPARSER_H
+
+#include <QtGlobal>
+#include "byteview.h"
+
+// Jiffy counters of one "cpu" line in /proc/stat (all in clock ticks)
+struct CpuTimes {
+    quint64 user = 0;
+    quint64 nice = 0;
+    quint64 system = 0;
+    quint64 idle = 0;
+    quint64 iowait = 0;
+    quint64 irq = 0;
+    quint64 softirq = 0;
+    quint64 steal = 0;
+    quint64 guest = 0;          // Already accounted in user
+    quint64 guestNice = 0;      // Already accounted in nice
+
+    quint64 idleTotal() const {
+        return idle + iowait;
+    }
+
+    // guest/guest_nice are excluded - the kernel folds them into user/nice
+    quint64 total() const {
+        return user + nice + system + idle + iowait + irq + softirq + steal;
+    }
+};
+
+// Everything /proc/stat reports except the interrupt/softirq breakdowns
+struct ProcStatData {
+    CpuTimes cpu;                   // Aggregate "cpu " line
+    int coreCount = 0;              // Highest "cpuN" index + 1
+    quint64 contextSwitches = 0;    // ctxt
+    qint64 bootTime = 0;            // btime (seconds since epoch)
+    quint64 processes = 0;          // Forks since boot
+    int procsRunning = 0;
+    int procsBlocked = 0;
+};
+
+// Single-pass, allocation-free /proc/stat parser working on raw bytes
+class ProcStatParser
+{
+public:
+    // Per-core counters are written structure-of-arrays style into
+    // coreTotal/coreIdle at the cpuN index, up to coreCapacity entries.
+    // out.coreCount may exceed coreCapacity - grow the arrays and re-parse.
+    static bool parse(const ByteView &bytes, ProcStatData &out,
+                      quint64 *coreTotal = nullptr, quint64 *coreIdle = nullptr,
+                      int coreCapacity = 0);
+
+    // Parse up to 10 jiffy fields starting at p, returns the number parsed
+    static int parseCpuTimes(const char *p, const char *end, CpuTimes &out);
+};
+
+#endif // PROCSTATPARSER_H
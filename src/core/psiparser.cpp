@@ -0,0 +1,101 @@
+#include "psiparser.h"
+#include <cstring>
+
+namespace {
+    inline quint64 parseNumber(const char *&p, const char *end)
+    {
+        quint64 result = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            result = result * 10 + quint64(*p - '0');
+            ++p;
+        }
+
+        return result;
+    }
+
+    // "12.34" - the kernel always prints two decimals
+    inline double parseDecimal(const char *&p, const char *end)
+    {
+        double result = double(parseNumber(p, end));
+        if (p < end && *p == '.') {
+            ++p;
+            double scale = 0.1;
+            while (p < end && *p >= '0' && *p <= '9') {
+                result += (*p - '0') * scale;
+                scale *= 0.1;
+                ++p;
+            }
+        }
+
+        return result;
+    }
+
+    void parseLine(const char *p, const char *end, PressureLine &line)
+    {
+        line = PressureLine();
+
+        // key=value pairs in fixed order, but match by key anyway
+        while (p < end) {
+            while (p < end && *p == ' ') {
+                ++p;
+            }
+
+            const char *key = p;
+            while (p < end && *p != '=' && *p != ' ') {
+                ++p;
+            }
+            const int keyLength = int(p - key);
+            if (p >= end || *p != '=') {
+                continue;
+            }
+            ++p;
+
+            if (keyLength == 5 && std::memcmp(key, "avg10", 5) == 0) {
+                line.avg10 = parseDecimal(p, end);
+            }
+            else if (keyLength == 5 && std::memcmp(key, "avg60", 5) == 0) {
+                line.avg60 = parseDecimal(p, end);
+            }
+            else if (keyLength == 6 && std::memcmp(key, "avg300", 6) == 0) {
+                line.avg300 = parseDecimal(p, end);
+            }
+            else if (keyLength == 5 && std::memcmp(key, "total", 5) == 0) {
+                line.totalUs = parseNumber(p, end);
+            }
+
+            // Skip whatever is left of an unknown value
+            while (p < end && *p != ' ') {
+                ++p;
+            }
+        }
+
+        line.valid = true;
+    }
+}
+
+bool PsiParser::parse(const ByteView &bytes, PressureStats &out)
+{
+    const char *p = bytes.begin();
+    const char *end = bytes.end();
+
+    out.some.valid = false;
+    out.full.valid = false;
+
+    while (p < end) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+
+        if (lineEnd - p > 5 && std::memcmp(p, "some ", 5) == 0) {
+            parseLine(p + 5, lineEnd, out.some);
+        }
+        else if (lineEnd - p > 5 && std::memcmp(p, "full ", 5) == 0) {
+            parseLine(p + 5, lineEnd, out.full);
+        }
+
+        p = lineEnd + 1;
+    }
+
+    return out.some.valid;
+}
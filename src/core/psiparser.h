@@ -0,0 +1,32 @@
+#ifndef PSIPARSER_H
+#define PSIPARSER_H
+
+#include <QtGlobal>
+#include "byteview.h"
+
+// One "some"/"full" line of a PSI file
+struct PressureLine {
+    double avg10 = 0.0;         // Percent of wall time stalled, 10 s average
+    double avg60 = 0.0;
+    double avg300 = 0.0;
+    quint64 totalUs = 0;        // Cumulative stall time (microseconds)
+    bool valid = false;
+};
+
+// /proc/pressure/<resource> or <cgroup>/<resource>.pressure
+struct PressureStats {
+    PressureLine some;          // At least one task stalled
+    PressureLine full;          // All non-idle tasks stalled (not for cpu before 5.13)
+};
+
+// Allocation-free parser for the PSI text format:
+//   some avg10=0.12 avg60=0.05 avg300=0.01 total=123456
+//   full avg10=0.00 avg60=0.00 avg300=0.00 total=7890
+class PsiParser
+{
+public:
+    // Returns true when at least the "some" line was found
+    static bool parse(const ByteView &bytes, PressureStats &out);
+};
+
+#endif // PSIPARSER_H
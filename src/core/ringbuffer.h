@@ -0,0 +1,153 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <QVector>
+#include <QtGlobal>
+
+// Contiguous run of elements inside a RingBuffer
+template <typename T>
+struct RingSpan {
+    const T *data = nullptr;
+    int size = 0;
+
+    const T *begin() const {
+        return data;
+    }
+
+    const T *end() const {
+        return data + size;
+    }
+};
+
+// Fixed-capacity history buffer. append() overwrites the oldest element once
+// full, so a sample costs O(1) instead of QVector::removeFirst()'s memmove.
+// Storage is allocated once; readers get the contents as at most two
+// contiguous spans (oldest first) without copying.
+template <typename T>
+class RingBuffer
+{
+public:
+    explicit RingBuffer(int capacity = 0) {
+        setCapacity(capacity);
+    }
+
+    // Drops the contents
+    void setCapacity(int capacity) {
+        m_storage.fill(T(), qMax(0, capacity));
+        m_head = 0;
+        m_size = 0;
+        ++m_sequence;
+    }
+
+    int capacity() const {
+        return m_storage.size();
+    }
+
+    int size() const {
+        return m_size;
+    }
+
+    bool isEmpty() const {
+        return m_size == 0;
+    }
+
+    bool isFull() const {
+        return m_size == m_storage.size();
+    }
+
+    void clear() {
+        m_head = 0;
+        m_size = 0;
+        ++m_sequence;
+    }
+
+    void append(const T &value) {
+        const int capacity = m_storage.size();
+        if (capacity == 0) {
+            return;
+        }
+
+        int tail = m_head + m_size;
+        if (tail >= capacity) {
+            tail -= capacity;
+        }
+        m_storage[tail] = value;
+
+        if (m_size < capacity) {
+            ++m_size;
+        } else if (++m_head == capacity) {
+            m_head = 0;
+        }
+        ++m_sequence;
+    }
+
+    // 0 is the oldest element
+    const T &at(int index) const {
+        Q_ASSERT(index >= 0 && index < m_size);
+        int slot = m_head + index;
+        if (slot >= m_storage.size()) {
+            slot -= m_storage.size();
+        }
+        return m_storage.at(slot);
+    }
+
+    const T &operator[](int index) const {
+        return at(index);
+    }
+
+    const T &first() const {
+        return at(0);
+    }
+
+    const T &last() const {
+        return at(m_size - 1);
+    }
+
+    // Oldest run, then the wrapped-around run (empty until the buffer wraps)
+    RingSpan<T> firstSpan() const {
+        RingSpan<T> span;
+        span.data = m_storage.constData() + m_head;
+        span.size = qMin(m_size, m_storage.size() - m_head);
+        return span;
+    }
+
+    RingSpan<T> secondSpan() const {
+        RingSpan<T> span;
+        span.data = m_storage.constData();
+        span.size = m_size - firstSpan().size;
+        return span;
+    }
+
+    // Calls fn(value) oldest first
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (const RingSpan<T> &span : { firstSpan(), secondSpan() }) {
+            for (const T &value : span) {
+                fn(value);
+            }
+        }
+    }
+
+    // Bumped on every change - lets views skip redraws when nothing is new
+    quint64 sequence() const {
+        return m_sequence;
+    }
+
+    // Linearised copy, for callers that need a QVector
+    QVector<T> toVector() const {
+        QVector<T> result;
+        result.reserve(m_size);
+        forEach([&result](const T &value) {
+            result.append(value);
+        });
+        return result;
+    }
+
+private:
+    QVector<T> m_storage;
+    int m_head = 0;             // Slot of the oldest element
+    int m_size = 0;
+    quint64 m_sequence = 0;
+};
+
+#endif // RINGBUFFER_H
@@ -0,0 +1,43 @@
+#ifndef SAMPLETIME_H
+#define SAMPLETIME_H
+
+#include <QtGlobal>
+#include <time.h>
+
+// Timestamp taken right at a /proc or sysfs read. CLOCK_MONOTONIC is immune
+// to NTP/DST jumps and needs no time-zone conversion; CLOCK_BOOTTIME also
+// counts suspend, so it lines up with kernel uptime-based counters.
+struct SampleTime {
+    qint64 monotonicNs = 0;
+    qint64 boottimeNs = 0;
+
+    bool isValid() const {
+        return monotonicNs > 0;
+    }
+
+    static SampleTime now() {
+        SampleTime time;
+        time.monotonicNs = read(CLOCK_MONOTONIC);
+        time.boottimeNs = read(CLOCK_BOOTTIME);
+        return time;
+    }
+
+    // Interval to a later sample in seconds (0 if either is unset)
+    double secondsTo(const SampleTime &later) const {
+        if (!isValid() || !later.isValid()) {
+            return 0.0;
+        }
+        return (later.monotonicNs - monotonicNs) / 1e9;
+    }
+
+private:
+    static qint64 read(clockid_t clock) {
+        timespec ts;
+        if (clock_gettime(clock, &ts) != 0) {
+            return 0;
+        }
+        return qint64(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+};
+
+#endif // SAMPLETIME_H
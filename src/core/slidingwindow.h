@@ -0,0 +1,126 @@
+#ifndef SLIDINGWINDOW_H
+#define SLIDINGWINDOW_H
+
+#include <QtGlobal>
+#include <cmath>
+#include <deque>
+
+// Aggregates of the samples inside one window
+struct WindowStats {
+    int count = 0;
+    double min = 0.0;
+    double max = 0.0;
+    double mean = 0.0;
+    double stddev = 0.0;            // Population standard deviation
+    double rate = 0.0;              // Change per second, newest vs oldest sample
+};
+
+// Time-based sliding window over one series. Every add() is amortised O(1):
+// expired samples leave from the front, min/max come from monotonic deques
+// and mean/variance from a running Welford sum that supports removal, so
+// stats() never rescans the window.
+class SlidingWindow
+{
+public:
+    explicit SlidingWindow(qint64 lengthMs = 0)
+        : m_length(lengthMs)
+    {
+    }
+
+    qint64 length() const {
+        return m_length;
+    }
+
+    void clear() {
+        m_samples.clear();
+        m_min.clear();
+        m_max.clear();
+        m_mean = 0.0;
+        m_m2 = 0.0;
+    }
+
+    // Timestamps must not go backwards
+    void add(qint64 timestampMs, double value) {
+        if (!m_samples.empty() && timestampMs < m_samples.back().timestamp) {
+            clear();
+        }
+
+        const Sample sample = { timestampMs, value };
+
+        // Later samples that are smaller (larger) can never be the max (min)
+        while (!m_min.empty() && m_min.back().value >= value) {
+            m_min.pop_back();
+        }
+        m_min.push_back(sample);
+        while (!m_max.empty() && m_max.back().value <= value) {
+            m_max.pop_back();
+        }
+        m_max.push_back(sample);
+
+        m_samples.push_back(sample);
+        const double delta = value - m_mean;
+        m_mean += delta / m_samples.size();
+        m_m2 += delta * (value - m_mean);
+
+        expire(timestampMs - m_length);
+    }
+
+    WindowStats stats() const {
+        WindowStats result;
+        result.count = int(m_samples.size());
+        if (m_samples.empty()) {
+            return result;
+        }
+
+        result.min = m_min.front().value;
+        result.max = m_max.front().value;
+        result.mean = m_mean;
+        result.stddev = std::sqrt(qMax(0.0, m_m2 / m_samples.size()));
+
+        const Sample &oldest = m_samples.front();
+        const Sample &newest = m_samples.back();
+        if (newest.timestamp > oldest.timestamp) {
+            result.rate = (newest.value - oldest.value) * 1000.0 / (newest.timestamp - oldest.timestamp);
+        }
+        return result;
+    }
+
+private:
+    struct Sample {
+        qint64 timestamp;
+        double value;
+    };
+
+    // Drop samples at or before cutoff, reversing their Welford update
+    void expire(qint64 cutoff) {
+        while (!m_samples.empty() && m_samples.front().timestamp <= cutoff) {
+            const double value = m_samples.front().value;
+            m_samples.pop_front();
+
+            if (m_samples.empty()) {
+                m_mean = 0.0;
+                m_m2 = 0.0;
+            } else {
+                const double delta = value - m_mean;
+                m_mean -= delta / m_samples.size();
+                m_m2 -= delta * (value - m_mean);
+            }
+        }
+
+        while (!m_min.empty() && m_min.front().timestamp <= cutoff) {
+            m_min.pop_front();
+        }
+        while (!m_max.empty() && m_max.front().timestamp <= cutoff) {
+            m_max.pop_front();
+        }
+    }
+
+    qint64 m_length;
+    std::deque<Sample> m_samples;
+    std::deque<Sample> m_min;       // Increasing values, front is the minimum
+    std::deque<Sample> m_max;       // Decreasing values, front is the maximum
+    double m_mean = 0.0;
+    double m_m2 = 0.0;              // Sum of squared deviations from the mean
+};
+
+#endif // SLIDINGWINDOW_H
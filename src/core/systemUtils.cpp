@@ -1,5 +1,7 @@
 #include "systemUtils.h"
 #include "constants.h"
+#include "procstatparser.h"
+#include "meminfoparser.h"
 #include <QFile>
 #include <QTextStream>
 #include <QDateTime>
@@ -57,6 +59,41 @@ qint64 SystemUtils::parseInt64(const QString &str, bool *ok)
     return valid ? result : 0;
 }
 
+qint64 SystemUtils::parseInt64(const ByteView &bytes, bool *ok)
+{
+    const char *p = bytes.begin();
+    const char *end = bytes.end();
+
+    // Skip leading whitespace
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n')) {
+        ++p;
+    }
+
+    bool negative = false;
+    if (p < end && *p == '-') {
+        negative = true;
+        ++p;
+    }
+
+    const char *digits = p;
+    qint64 result = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        result = result * 10 + (*p - '0');
+        ++p;
+    }
+
+    bool valid = p > digits;
+    if (ok) {
+        *ok = valid;
+    }
+
+    if (!valid) {
+        return 0;
+    }
+
+    return negative ? -result : result;
+}
+
 QString SystemUtils::getHostname()
 {
     // Try Linux/proc filesystem first
@@ -113,37 +150,19 @@ double SystemUtils::getCPUUsageSimple()
         return 42.5; // Fake data for testing
     }
 
-    QString statContent = readFile(Constants::PROC_STAT);
-    if (statContent.isEmpty()) {
+    ProcFileReader reader(Constants::PROC_STAT);
+    ProcStatData stat;
+    if (!ProcStatParser::parse(reader.read(), stat)) {
         return 0.0;
     }
 
-    // Parse /proc/stat format
-    // "cpu user nice system idle irq softirq steal gues guest_nice"
-    QStringList lines = statContent.split('\n');
-    if (lines.isEmpty()) {
-        return 0.0;
-    }
-
-    QString cpuLine = lines.first();
-
-    QStringList values = cpuLine.split(' ', Qt::SkipEmptyParts);
-    if (values.size() < 5) {
-        return 0.0;
-    }
-
-    // Extract CPU time values (in clock ticks)
-    qint64 user = parseInt64(values[1]);    // User processes
-    qint64 nice = parseInt64(values[2]);    // Low prority user processs
-    qint64 system = parseInt64(values[3]);  // Kernel processes
-    qint64 idle = parseInt64(values[4]);     // Idle time
-
-    qint64 total = user + nice + system + idle;
+    // Usage since boot from the aggregate "cpu " line
+    quint64 total = stat.cpu.total();
     if (total == 0) {
         return 0.0; // Avoid division by zero
     }
 
-    qint64 active = user + nice + system;
+    quint64 active = total - stat.cpu.idleTotal();
 
     double usage = ((double)active / total) * 100.0;
 
@@ -156,25 +175,14 @@ double SystemUtils::getMemoryUsageSimple()
         return 67.8; // fake data
     }
 
-    QStringList lines = readFileLines(Constants::PROC_MEMINFO);
-    qint64 memTotal = 0;
-    qint64 memAvaiable = 0;
-
-    for (const QString &line : lines) {
-        if (line.startsWith("MemTotal:")) {
-            QStringList parts = line.split(' ', Qt::SkipEmptyParts);
-            if (parts.size() >= 2) {
-                memTotal = parseInt64(parts[1]) * 1024;  // Convert KB to bytes
-            }
-        }
-        else if (line.startsWith("MemAvailable:")) {
-            QStringList parts = line.split(' ', Qt::SkipEmptyParts);
-            if (parts.size() >= 2) {
-                memAvaiable = parseInt64(parts[1]) * 1024;  // Convert KB to bytes
-            }
-        }
+    ProcFileReader reader(Constants::PROC_MEMINFO);
+    MeminfoData meminfo;
+    if (!MeminfoParser::parse(reader.read(), meminfo)) {
+        return 0.0;
     }
 
+    qint64 memTotal = meminfo.value(MeminfoData::MemTotal);
+    qint64 memAvaiable = meminfo.value(MeminfoData::MemAvailable);
     if (memTotal == 0) {
         return 0.0;
     }
@@ -3,6 +3,7 @@
 
 #include <QString>
 #include <QStringList>
+#include "procfilereader.h"
 
 class SystemUtils
 {
@@ -12,6 +13,8 @@ public:
     static QStringList readFileLines(const QString &filePath);
     static double parseDouble(const QString &str, bool *ok = nullptr);
     static qint64 parseInt64(const QString &str, bool *ok = nullptr);
+    // Parse a decimal integer straight from raw bytes (no QString round-trip)
+    static qint64 parseInt64(const ByteView &bytes, bool *ok = nullptr);
     static QString getHostname();
     static QString getCurrentTime();
     static QString getUptime();
@@ -1,28 +1,28 @@
 #include "basemonitor.h"
-#include "../../core/Constants.h"
+#include "../../controller/datacontroller.h"
+#include "../../core/constants.h"
 #include <QDebug>
 
 BaseMonitor::BaseMonitor(QObject *parent)
     : QObject{parent}
-    , m_timer(new QTimer(this))
+    , m_controller(DataController::acquire())
     , m_state(Stopped)
     , m_updateInterval(Constants::UPDATE_INTERVAL)
 {
-    // Connectt timer too our slot
-    connect(m_timer, &QTimer::timeout, this, &BaseMonitor::onTimerTimeout);
-
-    m_timer->setInterval(m_updateInterval);
 }
 
 BaseMonitor::~BaseMonitor()
 {
-    // QTimer will be auto-deleted by Qt parent system
+    // Subclasses call stop() in their destructors so collectData() never runs
+    // on a half-destroyed object; this is the last-resort drain
     stop();
+
+    DataController::release();
 }
 
 void BaseMonitor::start()
 {
-    if (m_state == Running) {
+    if (state() == Running) {
         return;  // Already running
     }
 
@@ -31,47 +31,33 @@ void BaseMonitor::start()
     // Change state and notify listeners
     setState(Running);
 
-    m_timer->start();
+    m_controller->addMonitor(this, m_updateInterval);
 
     updateNow();
 }
 
 void BaseMonitor::stop()
 {
-    if (m_state == Stopped) {
+    // Always drain - a manual updateNow() may be pending even when stopped
+    m_controller->removeMonitor(this);
+
+    if (state() == Stopped) {
         return;     // Already stopped
     }
 
     qDebug() << "Stopping monitor...";
 
-    m_timer->stop();
-
     setState(Stopped);
 }
 
 void BaseMonitor::updateNow()
 {
-    if (m_state == Error) {
+    if (state() == Error) {
         // Don't update if in error state
         return;
     }
 
-    try {
-        // Pure virtual method - specific to each monitor type
-        collectData();
-
-        if (m_state != Running) {
-            setState(Running); // Recover from error state
-        }
-
-        // Notify listeners that new data available
-        emit dateUpdate();
-
-    } catch (const std::exception &e) {
-        emitError(QString("Data collection failed: %1").arg(e.what()));
-    } catch (...) {
-        emitError("Unknown error during data collection");
-    }
+    m_controller->collectNow(this);
 }
 
 void BaseMonitor::setUpdateInterval(int milliseconds)
@@ -81,9 +67,9 @@ void BaseMonitor::setUpdateInterval(int milliseconds)
         return;
     }
 
-    // Change takes effect immediately if timer running
+    // Change takes effect on the next scheduler tick
     m_updateInterval = milliseconds;
-    m_timer->setInterval(milliseconds);
+    m_controller->setMonitorInterval(this, milliseconds);
 
     qDebug() << "Update interval set to:" << milliseconds << "ms";
 }
@@ -93,14 +79,39 @@ int BaseMonitor::updateInterval() const
     return m_updateInterval;
 }
 
+void BaseMonitor::appendMetrics(MetricSample &sample) const
+{
+    Q_UNUSED(sample)
+}
+
+void BaseMonitor::publish(const std::function<void()> &apply)
+{
+    QMetaObject::invokeMethod(this, [this, apply]() {
+        apply();
+
+        // Notify listeners that new data available
+        emit dateUpdate();
+    }, Qt::QueuedConnection);
+}
+
+void BaseMonitor::moveToSampler(QObject *object)
+{
+    object->moveToThread(m_controller->samplerThread());
+}
+
+void BaseMonitor::runOnSampler(const std::function<void()> &task, bool wait)
+{
+    m_controller->runOnSampler(task, wait);
+}
+
 void BaseMonitor::setState(MonitorState newState)
 {
-    if (m_state == newState) {
+    MonitorState oldState = state();
+    if (oldState == newState) {
         return;     // No change
     }
 
-    MonitorState oldState = m_state;
-    m_state = newState;
+    m_state.storeRelease(newState);
 
     qDebug() << "Monitor state changed from " << oldState << " to" << newState;
 
@@ -117,8 +128,29 @@ void BaseMonitor::emitError(const QString &message)
     emit errorOccurred(message);
 }
 
-void BaseMonitor::onTimerTimeout()
+bool BaseMonitor::collectOnSampler()
 {
-    // Called every m_updateInterval milliseconds
-    updateNow();
+    if (state() == Error) {
+        return false;
+    }
+
+    QString error;
+
+    try {
+        // Pure virtual method - specific to each monitor type
+        collectData();
+        return true;
+
+    } catch (const std::exception &e) {
+        error = QString("Data collection failed: %1").arg(e.what());
+    } catch (...) {
+        error = "Unknown error during data collection";
+    }
+
+    // State and signals belong to the GUI thread
+    QMetaObject::invokeMethod(this, [this, error]() {
+        emitError(error);
+    }, Qt::QueuedConnection);
+
+    return false;
 }
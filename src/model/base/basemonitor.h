@@ -2,9 +2,17 @@
 #define BASEMONITOR_H
 
 #include <QObject>
-#include <QTimer>
 #include <QString>
+#include <QAtomicInt>
+#include <functional>
 
+class DataController;
+struct MetricSample;
+
+// Monitors live on the GUI thread, but collectData() runs on the shared
+// sampler thread, driven by the DataController scheduler. Subclasses keep
+// their working state sampler-side and hand immutable snapshots back with
+// publish(); signals and accessors therefore only see GUI-thread data.
 class BaseMonitor : public QObject
 {
     Q_OBJECT
@@ -18,24 +26,24 @@ public:
     explicit BaseMonitor(QObject *parent = nullptr);
     virtual ~BaseMonitor();
 
-    // Set uo QTimer, changes state to Running
+    // Register with the scheduler, changes state to Running
     virtual void start();
-    // Stop QTimer, changes state to Stopped
+    // Unregister, waits for an in-flight collection, changes state to Stopped
     virtual void stop();
-    // Useful for manual refresh
+    // Useful for manual refresh - queues one collection on the sampler thread
     virtual void updateNow();
 
     // State management
     MonitorState state() const {
-        return m_state;
+        return MonitorState(m_state.loadAcquire());
     }
 
     // Convenince method check if active
     bool isRunning() const {
-        return m_state == Running;
+        return state() == Running;
     }
 
-    // Configuration
+    // Configuration - the scheduler ticks at the gcd of all intervals
     void setUpdateInterval(int milliseconds);
     int updateInterval() const;
 
@@ -48,23 +56,36 @@ signals:
     void stateChanged(MonitorState newState);
 
 protected:
-    // Core data collection logic goes here
+    // Core data collection logic goes here - called on the sampler thread
     virtual void collectData() = 0;
 
+    // Add this monitor's headline values to the scheduler's batch sample.
+    // Called on the sampler thread right after a successful collectData().
+    virtual void appendMetrics(MetricSample &sample) const;
+
+    // Queue a snapshot update onto the monitor's (GUI) thread, followed by
+    // dateUpdate(). Call from collectData() with a lambda capturing copies.
+    void publish(const std::function<void()> &apply);
+
+    // Place helper objects (socket notifiers, watchers) on the sampler thread
+    void moveToSampler(QObject *object);
+    void runOnSampler(const std::function<void()> &task, bool wait = false);
+
     // Used by subclasses to report state changes
     void setState(MonitorState newState);
 
     // Centralized error handling
     void emitError(const QString &message);
 
-protected slots:
-    // Calls collectData() periodcally
-    void onTimerTimeout();
-
 private:
-    QTimer *m_timer;        // Update timer
-    MonitorState m_state;   // Currnet state
-    int m_updateInterval;   // Update frequency (ms)
+    friend class DataController;
+
+    // Runs collectData() on the sampler thread, false if it failed
+    bool collectOnSampler();
+
+    DataController *m_controller;   // Shared scheduler
+    QAtomicInt m_state;             // Currnet state, read from both threads
+    int m_updateInterval;           // Update frequency (ms)
 
     // Disable copy constructor/assignment
     BaseMonitor(const BaseMonitor &) = delete;
@@ -0,0 +1,38 @@
+#include "samplerthread.h"
+#include <QDebug>
+
+QMutex SamplerThread::s_mutex;
+QThread *SamplerThread::s_thread = nullptr;
+int SamplerThread::s_refCount = 0;
+
+QThread *SamplerThread::acquire()
+{
+    QMutexLocker locker(&s_mutex);
+
+    if (!s_thread) {
+        s_thread = new QThread;
+        s_thread->setObjectName("SamplerThread");
+        s_thread->start();
+        qDebug() << "Sampler thread started";
+    }
+
+    ++s_refCount;
+    return s_thread;
+}
+
+void SamplerThread::release()
+{
+    QMutexLocker locker(&s_mutex);
+
+    if (s_refCount <= 0 || --s_refCount > 0) {
+        return;
+    }
+
+    // Last monitor gone - pending deleteLater() calls run as the loop exits
+    s_thread->quit();
+    s_thread->wait();
+    delete s_thread;
+    s_thread = nullptr;
+
+    qDebug() << "Sampler thread stopped";
+}
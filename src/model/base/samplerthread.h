@@ -0,0 +1,22 @@
+#ifndef SAMPLERTHREAD_H
+#define SAMPLERTHREAD_H
+
+#include <QThread>
+#include <QMutex>
+
+// Shared worker thread that runs every monitor's collectData(), so /proc and
+// sysfs reads never block painting or input on the GUI thread.
+// Reference counted: the first monitor starts it, the last one stops it.
+class SamplerThread
+{
+public:
+    static QThread *acquire();
+    static void release();
+
+private:
+    static QMutex s_mutex;
+    static QThread *s_thread;
+    static int s_refCount;
+};
+
+#endif // SAMPLERTHREAD_H
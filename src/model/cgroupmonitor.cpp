@@ -0,0 +1,435 @@
+#include "cgroupmonitor.h"
+#include "../core/constants.h"
+#include "../controller/datacontroller.h"
+#include <QDebug>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/resource.h>
+
+namespace {
+    const int EVENT_BUFFER_SIZE = 64 * 1024;
+    const int FILE_BUFFER_SIZE = 8192;      // memory.stat is the largest, ~1.5 KB
+
+    // One-shot read of a small file relative to dirFd into buffer
+    ByteView readAt(int dirFd, const char *path, char *buffer, int capacity)
+    {
+        ByteView view;
+
+        int fd = ::openat(dirFd, path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return view;    // Controller not enabled here, or cgroup removed
+        }
+
+        ssize_t n;
+        do {
+            n = ::read(fd, buffer, capacity);
+        } while (n < 0 && errno == EINTR);
+        ::close(fd);
+
+        if (n > 0) {
+            view.data = buffer;
+            view.size = int(n);
+        }
+        return view;
+    }
+
+    inline quint64 delta(quint64 current, quint64 previous)
+    {
+        return current >= previous ? current - previous : 0;
+    }
+}
+
+CgroupMonitor::CgroupMonitor(QObject *parent)
+    : BaseMonitor(parent)
+{
+    setUpdateInterval(Constants::CGROUP_UPDATE_INTERVAL);
+
+    // One directory descriptor per cgroup - thousands on a container host,
+    // past the usual 1024 soft limit. The hard limit is ours to take.
+    struct rlimit limit;
+    if (::getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        ::setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    m_eventBuffer.resize(EVENT_BUFFER_SIZE);
+
+    qDebug() << "CgroupMonitor initialized";
+}
+
+CgroupMonitor::~CgroupMonitor()
+{
+    // Drain the sampler before our members go away
+    stop();
+    closeHierarchy();
+
+    if (m_inotifyFd >= 0) {
+        ::close(m_inotifyFd);
+    }
+}
+
+void CgroupMonitor::collectData()
+{
+    const SampleTime start = SampleTime::now();
+
+    if (m_rescan) {
+        closeHierarchy();
+        if (!openHierarchy()) {
+            throw std::runtime_error("cgroup v2 hierarchy not available");
+        }
+        m_rescan = false;
+        qDebug() << "Cgroup hierarchy scanned -" << m_nodes.size() << "cgroups";
+    }
+    else if (processEvents()) {
+        qDebug() << "Cgroup hierarchy changed -" << m_nodes.size() << "cgroups";
+    }
+
+    const double elapsedSec = m_previousTime.secondsTo(start);
+    m_previousTime = start;
+    m_sample.timestamp = start;
+
+    for (int i = 0; i < m_nodes.size(); ++i) {
+        readNode(i, elapsedSec);
+    }
+
+    // Quotas need every node's cpu.max, so they come after the reads
+    int throttled = 0;
+    int busiest = -1;
+    for (int i = 0; i < m_nodes.size(); ++i) {
+        CgroupStats &stats = m_sample.cgroups[i];
+
+        // cpuUsage is percent of one CPU, the quota is in CPUs
+        stats.cpuQuota = effectiveQuota(i);
+        stats.cpuQuotaUsage = stats.cpuQuota > 0.0 ? stats.cpuUsage / stats.cpuQuota : 0.0;
+
+        if (stats.throttledPercent > 0.0) {
+            ++throttled;
+        }
+        if (stats.cpuQuotaUsage > 0.0 &&
+            (busiest < 0 || stats.cpuQuotaUsage > m_sample.cgroups.at(busiest).cpuQuotaUsage)) {
+            busiest = i;
+        }
+    }
+
+    m_sample.throttledCount = throttled;
+    m_sample.maxQuotaUsage = busiest >= 0 ? m_sample.cgroups.at(busiest).cpuQuotaUsage : 0.0;
+    m_sample.busiest = busiest >= 0 ? m_sample.cgroups.at(busiest).path : QString();
+    m_sample.scanTime = start.secondsTo(SampleTime::now());
+
+    // Hand an immutable copy to the GUI thread
+    const CgroupData snapshot = m_sample;
+    publish([this, snapshot]() {
+        m_cgroupData = snapshot;
+        emit cgroupDataUpdated(m_cgroupData);
+    });
+
+    qDebug() << "Cgroups:" << m_nodes.size() << "Throttled:" << throttled
+             << "Max quota usage:" << m_sample.maxQuotaUsage << "%" << m_sample.busiest
+             << "Scan:" << m_sample.scanTime * 1000.0 << "ms";
+}
+
+void CgroupMonitor::appendMetrics(MetricSample &sample) const
+{
+    sample.values.insert("cgroup.count", m_nodes.size());
+    sample.values.insert("cgroup.throttled", m_sample.throttledCount);
+    sample.values.insert("cgroup.max_quota_usage", m_sample.maxQuotaUsage);
+}
+
+bool CgroupMonitor::openHierarchy()
+{
+    // Pure v2 systems mount it at /sys/fs/cgroup, hybrid ones at unified/
+    if (m_mountPath.isEmpty()) {
+        const QByteArray base = Constants::SYS_CGROUP_DIR.toLocal8Bit();
+        if (::access((base + "/cgroup.controllers").constData(), F_OK) == 0) {
+            m_mountPath = base;
+        }
+        else if (::access((base + "/unified/cgroup.controllers").constData(), F_OK) == 0) {
+            m_mountPath = base + "/unified";
+        }
+        else {
+            return false;
+        }
+    }
+
+    if (m_inotifyFd < 0) {
+        m_inotifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_inotifyFd < 0) {
+            qDebug() << "inotify unavailable - new cgroups will not be picked up:" << std::strerror(errno);
+        }
+    }
+
+    addSubtree(AT_FDCWD, m_mountPath, QByteArray());
+    return !m_nodes.isEmpty();
+}
+
+void CgroupMonitor::closeHierarchy()
+{
+    for (const CgroupNode &node : m_nodes) {
+        if (node.watch >= 0) {
+            ::inotify_rm_watch(m_inotifyFd, node.watch);
+        }
+        ::close(node.dirFd);
+    }
+
+    m_nodes.clear();
+    m_pathIndex.clear();
+    m_watchIndex.clear();
+    m_sample.cgroups.clear();
+}
+
+void CgroupMonitor::addSubtree(int parentFd, const QByteArray &name, const QByteArray &path)
+{
+    if (m_pathIndex.contains(path)) {
+        return;     // Seen by both the listing and an IN_CREATE
+    }
+
+    const int index = addNode(parentFd, name, path);
+    if (index < 0) {
+        return;
+    }
+
+    // List children only after the watch is in place, so a mkdir racing the
+    // listing is never missed
+    const int dirFd = m_nodes.at(index).dirFd;
+    const int listFd = ::dup(dirFd);
+    DIR *dir = listFd >= 0 ? ::fdopendir(listFd) : nullptr;
+    if (!dir) {
+        if (listFd >= 0) {
+            ::close(listFd);
+        }
+        return;
+    }
+
+    QVector<QByteArray> children;
+    while (dirent *entry = ::readdir(dir)) {
+        if (entry->d_type == DT_DIR && entry->d_name[0] != '.') {
+            children.append(QByteArray(entry->d_name));
+        }
+    }
+    ::closedir(dir);
+
+    for (const QByteArray &child : children) {
+        addSubtree(dirFd, child, path.isEmpty() ? child : path + '/' + child);
+    }
+}
+
+int CgroupMonitor::addNode(int parentFd, const QByteArray &name, const QByteArray &path)
+{
+    CgroupNode node;
+    node.path = path;
+    node.dirFd = ::openat(parentFd, name.constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (node.dirFd < 0) {
+        if (errno != ENOENT) {
+            qDebug() << "Cannot open cgroup" << path << ":" << std::strerror(errno);
+        }
+        return -1;  // ENOENT: removed again before we got to it
+    }
+
+    const int index = m_nodes.size();
+
+    if (m_inotifyFd >= 0) {
+        const QByteArray fullPath = path.isEmpty() ? m_mountPath : m_mountPath + '/' + path;
+        node.watch = ::inotify_add_watch(m_inotifyFd, fullPath.constData(),
+                                         IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR);
+        if (node.watch >= 0) {
+            m_watchIndex.insert(node.watch, index);
+        }
+    }
+
+    CgroupStats stats;
+    stats.path = '/' + QString::fromLocal8Bit(path);
+    stats.depth = path.isEmpty() ? 0 : path.count('/') + 1;
+
+    m_nodes.append(node);
+    m_sample.cgroups.append(stats);
+    m_pathIndex.insert(path, index);
+
+    return index;
+}
+
+void CgroupMonitor::removeSubtree(const QByteArray &path)
+{
+    const QByteArray prefix = path + '/';
+
+    QVector<int> indices;
+    for (int i = 0; i < m_nodes.size(); ++i) {
+        const QByteArray &nodePath = m_nodes.at(i).path;
+        if (nodePath == path || nodePath.startsWith(prefix)) {
+            indices.append(i);
+        }
+    }
+
+    // Highest first - the row swapped into a removed slot is never one we
+    // still have to remove
+    std::sort(indices.begin(), indices.end(), std::greater<int>());
+    for (int index : indices) {
+        removeNode(index);
+    }
+}
+
+void CgroupMonitor::removeNode(int index)
+{
+    const CgroupNode &node = m_nodes.at(index);
+    if (node.watch >= 0) {
+        ::inotify_rm_watch(m_inotifyFd, node.watch);    // Usually gone with the directory
+        m_watchIndex.remove(node.watch);
+    }
+    ::close(node.dirFd);
+    m_pathIndex.remove(node.path);
+
+    const int last = m_nodes.size() - 1;
+    if (index != last) {
+        m_nodes[index] = m_nodes.at(last);
+        m_sample.cgroups[index] = m_sample.cgroups.at(last);
+
+        m_pathIndex.insert(m_nodes.at(index).path, index);
+        if (m_nodes.at(index).watch >= 0) {
+            m_watchIndex.insert(m_nodes.at(index).watch, index);
+        }
+    }
+
+    m_nodes.removeLast();
+    m_sample.cgroups.removeLast();
+}
+
+bool CgroupMonitor::processEvents()
+{
+    if (m_inotifyFd < 0) {
+        return false;
+    }
+
+    bool changed = false;
+
+    // Drain everything queued so a burst of container starts costs one pass
+    for (;;) {
+        ssize_t received = ::read(m_inotifyFd, m_eventBuffer.data(), m_eventBuffer.size());
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;  // EAGAIN - drained
+        }
+
+        const char *p = m_eventBuffer.constData();
+        const char *end = p + received;
+        while (p < end) {
+            const inotify_event *event = reinterpret_cast<const inotify_event *>(p);
+            p += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                m_rescan = true;    // Events lost - walk everything next tick
+                continue;
+            }
+            if (!(event->mask & IN_ISDIR) || event->len == 0) {
+                continue;
+            }
+
+            const int parent = m_watchIndex.value(event->wd, -1);
+            if (parent < 0) {
+                continue;
+            }
+
+            const QByteArray name(event->name);
+            const QByteArray &parentPath = m_nodes.at(parent).path;
+            const QByteArray path = parentPath.isEmpty() ? name : parentPath + '/' + name;
+
+            if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                addSubtree(m_nodes.at(parent).dirFd, name, path);
+                changed = true;
+            }
+            else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                removeSubtree(path);
+                changed = true;
+            }
+        }
+    }
+
+    return changed;
+}
+
+void CgroupMonitor::readNode(int index, double elapsedSec)
+{
+    char buffer[FILE_BUFFER_SIZE];
+
+    CgroupNode &node = m_nodes[index];
+    CgroupStats &stats = m_sample.cgroups[index];
+    const int dirFd = node.dirFd;
+
+    CgroupCpuStat cpu;
+    const bool haveCpu = CgroupParser::parseCpuStat(readAt(dirFd, "cpu.stat", buffer, sizeof(buffer)), cpu);
+
+    // The root and cgroups without the cpu controller have no cpu.max
+    CgroupCpuMax cpuMax;
+    if (CgroupParser::parseCpuMax(readAt(dirFd, "cpu.max", buffer, sizeof(buffer)), cpuMax) &&
+        cpuMax.quotaUsec > 0) {
+        node.ownQuota = double(cpuMax.quotaUsec) / cpuMax.periodUsec;
+    } else {
+        node.ownQuota = 0.0;
+    }
+
+    bool ok;
+    stats.memoryCurrent = CgroupParser::parseValue(readAt(dirFd, "memory.current", buffer, sizeof(buffer)));
+    stats.memoryMax = CgroupParser::parseValue(readAt(dirFd, "memory.max", buffer, sizeof(buffer)), &ok);
+    if (!ok) {
+        stats.memoryMax = -1;
+    }
+    CgroupParser::parseMemoryStat(readAt(dirFd, "memory.stat", buffer, sizeof(buffer)), stats.memory);
+
+    CgroupIoStat io;
+    CgroupParser::parseIoStat(readAt(dirFd, "io.stat", buffer, sizeof(buffer)), io);
+
+    if (node.hasPrevious && elapsedSec > 0) {
+        const quint64 periods = delta(cpu.nrPeriods, node.previousCpu.nrPeriods);
+        const quint64 throttled = delta(cpu.nrThrottled, node.previousCpu.nrThrottled);
+
+        stats.cpuUsage = delta(cpu.usageUsec, node.previousCpu.usageUsec) / (elapsedSec * 1e6) * 100.0;
+        stats.throttledPercent = periods > 0 ? double(throttled) / periods * 100.0 : 0.0;
+        stats.ioReadRate = delta(io.readBytes, node.previousIo.readBytes) / elapsedSec;
+        stats.ioWriteRate = delta(io.writeBytes, node.previousIo.writeBytes) / elapsedSec;
+    }
+    else {
+        // First sample of this cgroup
+        stats.cpuUsage = 0.0;
+        stats.throttledPercent = 0.0;
+        stats.ioReadRate = 0.0;
+        stats.ioWriteRate = 0.0;
+    }
+
+    stats.memoryUsage = stats.memoryMax > 0 ? double(stats.memoryCurrent) / stats.memoryMax * 100.0 : 0.0;
+
+    node.previousCpu = cpu;
+    node.previousIo = io;
+    node.hasPrevious = haveCpu;
+}
+
+double CgroupMonitor::effectiveQuota(int index) const
+{
+    // A child can set a larger cpu.max than its parent, but the parent's
+    // limit still caps it - the tightest one on the way to the root applies
+    double quota = m_nodes.at(index).ownQuota;
+    QByteArray path = m_nodes.at(index).path;
+
+    while (!path.isEmpty()) {
+        const int slash = path.lastIndexOf('/');
+        path.truncate(slash < 0 ? 0 : slash);
+
+        const int parent = m_pathIndex.value(path, -1);
+        if (parent < 0) {
+            break;
+        }
+        const double parentQuota = m_nodes.at(parent).ownQuota;
+        if (parentQuota > 0.0 && (quota <= 0.0 || parentQuota < quota)) {
+            quota = parentQuota;
+        }
+    }
+
+    return quota;
+}
@@ -0,0 +1,107 @@
+#ifndef CGROUPMONITOR_H
+#define CGROUPMONITOR_H
+
+#include "base/basemonitor.h"
+#include "../core/cgroupparser.h"
+#include "../core/sampletime.h"
+#include <QByteArray>
+#include <QHash>
+#include <QVector>
+
+// Resource usage of one cgroup over the last interval
+struct CgroupStats {
+    QString path;                   // "/" for the root, else "/system.slice/foo.service"
+    int depth = 0;
+
+    double cpuUsage = 0.0;          // Percent of one CPU
+    double cpuQuota = 0.0;          // Cores allowed by the tightest cpu.max up the tree, 0 = unlimited
+    double cpuQuotaUsage = 0.0;     // Percent of the quota, 0 without one
+    double throttledPercent = 0.0;  // Share of the interval's periods that were throttled
+
+    qint64 memoryCurrent = 0;
+    qint64 memoryMax = -1;          // -1 = unlimited
+    double memoryUsage = 0.0;       // Percent of memory.max, 0 without one
+    CgroupMemoryStat memory;
+
+    double ioReadRate = 0.0;        // Bytes per second
+    double ioWriteRate = 0.0;
+};
+
+struct CgroupData {
+    QVector<CgroupStats> cgroups;   // Unordered - rows are swap-removed on rmdir
+
+    // Headline values
+    int throttledCount = 0;         // Cgroups throttled during the interval
+    double maxQuotaUsage = 0.0;     // Closest any cgroup came to its cpu.max
+    QString busiest;                // Path of that cgroup
+
+    double scanTime = 0.0;          // Seconds spent reading the hierarchy
+    SampleTime timestamp;
+};
+
+// cgroup v2 hierarchy monitor. Every cgroup directory stays open, so the
+// per-tick reads are openat() relative to it - no path walks. The tree is
+// only rescanned where inotify reports mkdir/rmdir, never walked per tick.
+class CgroupMonitor : public BaseMonitor
+{
+    Q_OBJECT
+public:
+    explicit CgroupMonitor(QObject *parent = nullptr);
+    ~CgroupMonitor() override;
+
+    // Data access
+    const CgroupData &data() const {
+        return m_cgroupData;
+    }
+
+    const QVector<CgroupStats> &cgroups() const {
+        return m_cgroupData.cgroups;
+    }
+
+signals:
+    void cgroupDataUpdated(const CgroupData &data);
+
+protected:
+    void collectData() override;
+    void appendMetrics(MetricSample &sample) const override;
+
+private:
+    // One open cgroup directory, same index as m_sample.cgroups
+    struct CgroupNode {
+        QByteArray path;            // Relative to the mount, "" for the root
+        int dirFd = -1;
+        int watch = -1;
+        double ownQuota = 0.0;      // Cores from this cgroup's own cpu.max, 0 = unlimited
+        bool hasPrevious = false;
+        CgroupCpuStat previousCpu;
+        CgroupIoStat previousIo;
+    };
+
+    // Hierarchy maintenance
+    bool openHierarchy();
+    void closeHierarchy();
+    void addSubtree(int parentFd, const QByteArray &name, const QByteArray &path);
+    int addNode(int parentFd, const QByteArray &name, const QByteArray &path);
+    void removeSubtree(const QByteArray &path);
+    void removeNode(int index);
+    bool processEvents();
+
+    // Per tick
+    void readNode(int index, double elapsedSec);
+    double effectiveQuota(int index) const;
+
+    CgroupData m_cgroupData;        // Published data (GUI thread)
+
+    // Working state below is only touched on the sampler thread
+    CgroupData m_sample;
+    QVector<CgroupNode> m_nodes;
+    QHash<QByteArray, int> m_pathIndex;
+    QHash<int, int> m_watchIndex;   // inotify watch -> node
+    QByteArray m_mountPath;         // cgroup2 mount point
+    int m_inotifyFd = -1;
+    bool m_rescan = true;           // Full walk needed (start, queue overflow)
+    QByteArray m_eventBuffer;
+    SampleTime m_previousTime;
+};
+
+#endif // CGROUPMONITOR_H
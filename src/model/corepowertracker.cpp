@@ -0,0 +1,231 @@
+#include "corepowertracker.h"
+#include "../core/constants.h"
+#include "../core/systemUtils.h"
+#include <QDebug>
+#include <QFileInfo>
+#include <cstring>
+
+namespace {
+    inline quint64 parseNumber(const char *&p, const char *end)
+    {
+        while (p < end && *p == ' ') {
+            ++p;
+        }
+
+        quint64 result = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            result = result * 10 + quint64(*p - '0');
+            ++p;
+        }
+
+        return result;
+    }
+
+    bool readValue(ProcFileReader &reader, qint64 &value)
+    {
+        ByteView bytes = reader.read();
+        if (bytes.isEmpty()) {
+            return false;
+        }
+
+        bool ok;
+        value = SystemUtils::parseInt64(bytes, &ok);
+        return ok;
+    }
+
+    QString readAttribute(const QString &path)
+    {
+        if (!QFileInfo::exists(path)) {
+            return QString();
+        }
+        return SystemUtils::readFile(path).trimmed();
+    }
+
+    // Calls row(index, frequencyKHz, time) for every "freq time" line of
+    // cpufreq/stats/time_in_state; returns the number of rows
+    template <typename Row>
+    int forEachStateRow(const ByteView &table, Row row)
+    {
+        const char *p = table.begin();
+        const char *end = table.end();
+        int index = 0;
+
+        while (p < end) {
+            const char *lineEnd = static_cast<const char *>(std::memchr(p, '\n', end - p));
+            if (!lineEnd) {
+                lineEnd = end;
+            }
+
+            const quint64 frequency = parseNumber(p, lineEnd);
+            const quint64 time = parseNumber(p, lineEnd);
+            if (frequency > 0) {
+                row(index++, frequency, time);
+            }
+
+            p = lineEnd + 1;
+        }
+
+        return index;
+    }
+}
+
+CorePowerTracker::CoreFiles::~CoreFiles()
+{
+    qDeleteAll(idleTime);
+}
+
+CorePowerTracker::CorePowerTracker()
+{
+}
+
+CorePowerTracker::~CorePowerTracker()
+{
+    qDeleteAll(m_cores);
+}
+
+void CorePowerTracker::discover(int coreCount)
+{
+    qDeleteAll(m_cores);
+    m_cores.clear();
+    m_idleStateNames.clear();
+    m_idleStateLatencies.clear();
+    m_previousTime = SampleTime();
+
+    for (int cpu = 0; cpu < coreCount; ++cpu) {
+        const QString base = QString("%1/cpu%2").arg(Constants::SYS_CPU_DIR).arg(cpu);
+
+        CoreFiles *files = new CoreFiles;
+        files->currentFrequency.setPath(base + "/cpufreq/scaling_cur_freq");
+        files->policyMaxFrequency.setPath(base + "/cpufreq/scaling_max_freq");
+        files->governor.setPath(base + "/cpufreq/scaling_governor");
+        files->timeInState.setPath(base + "/cpufreq/stats/time_in_state");
+        files->hardwareMaxFrequency = readAttribute(base + "/cpufreq/cpuinfo_max_freq").toLongLong() / 1000.0;
+
+        // state0..N until the first gap; all cores share the driver's table
+        for (int state = 0; state < CorePowerState::MAX_IDLE_STATES; ++state) {
+            const QString stateDir = QString("%1/cpuidle/state%2").arg(base).arg(state);
+            if (!QFileInfo::exists(stateDir + "/time")) {
+                break;
+            }
+            files->idleTime.append(new ProcFileReader(stateDir + "/time"));
+
+            if (cpu == 0) {
+                m_idleStateNames.append(readAttribute(stateDir + "/name"));
+                m_idleStateLatencies.append(readAttribute(stateDir + "/latency").toInt());
+            }
+        }
+
+        m_cores.append(files);
+    }
+
+    qDebug() << "CorePowerTracker:" << coreCount << "cores," << m_idleStateNames.size()
+             << "idle states" << m_idleStateNames;
+}
+
+void CorePowerTracker::sample(QVector<CorePowerState> &states)
+{
+    const SampleTime now = SampleTime::now();
+    const double elapsedSec = m_previousTime.secondsTo(now);
+    m_previousTime = now;
+
+    const int count = qMin(states.size(), m_cores.size());
+    CorePowerState *state = states.data();
+
+    for (int i = 0; i < count; ++i) {
+        state[i].cpu = i;
+        sampleFrequency(*m_cores[i], state[i], elapsedSec);
+        sampleIdle(*m_cores[i], state[i], elapsedSec);
+    }
+}
+
+void CorePowerTracker::sampleFrequency(CoreFiles &files, CorePowerState &state, double elapsedSec)
+{
+    qint64 value;
+    state.frequency = readValue(files.currentFrequency, value) ? value / 1000.0 : 0.0;
+    state.policyMaxFrequency = readValue(files.policyMaxFrequency, value) ? value / 1000.0 : 0.0;
+    state.hardwareMaxFrequency = files.hardwareMaxFrequency;
+
+    // Only build a new QString when the governor actually changed
+    ByteView governor = files.governor.read();
+    int length = governor.size;
+    while (length > 0 && governor.data[length - 1] == '\n') {
+        --length;
+    }
+    if (length != files.governorBytes.size() ||
+        std::memcmp(governor.data, files.governorBytes.constData(), length) != 0) {
+        files.governorBytes = QByteArray(governor.data, length);
+        state.governor = QString::fromLatin1(files.governorBytes);
+    }
+
+    // Time-weighted frequency since the last sample; falls back to the
+    // instantaneous one without stats or on the first sample
+    state.averageFrequency = state.frequency;
+
+    ByteView table = files.timeInState.read();
+    if (table.isEmpty()) {
+        return;
+    }
+
+    QVector<quint64> &frequencies = files.stateFrequencies;
+    QVector<quint64> &times = files.stateTimes;
+    bool sameLayout = true;
+    double weighted = 0.0;
+    quint64 total = 0;
+
+    const int rows = forEachStateRow(table, [&](int index, quint64 frequency, quint64 time) {
+        if (!sameLayout || index >= frequencies.size() || frequencies[index] != frequency) {
+            sameLayout = false;
+            return;
+        }
+        const quint64 delta = time >= times[index] ? time - times[index] : 0;
+        weighted += double(frequency) * delta;
+        total += delta;
+        times[index] = time;
+    });
+
+    if (!sameLayout || rows != frequencies.size()) {
+        // First sample or the table changed (boost toggled) - restart from here
+        frequencies.resize(rows);
+        times.resize(rows);
+        forEachStateRow(table, [&](int index, quint64 frequency, quint64 time) {
+            frequencies[index] = frequency;
+            times[index] = time;
+        });
+        return;
+    }
+
+    if (elapsedSec > 0 && total > 0) {
+        state.averageFrequency = weighted / total / 1000.0;
+    }
+}
+
+void CorePowerTracker::sampleIdle(CoreFiles &files, CorePowerState &state, double elapsedSec)
+{
+    const int count = files.idleTime.size();
+    const bool haveInterval = elapsedSec > 0 && files.idleTimes.size() == count;
+    if (files.idleTimes.size() != count) {
+        files.idleTimes.fill(0, count);
+    }
+
+    quint64 *previous = files.idleTimes.data();
+    state.idleStateCount = count;
+    state.idleTotal = 0.0;
+
+    for (int i = 0; i < count; ++i) {
+        qint64 value;
+        if (!readValue(*files.idleTime[i], value)) {
+            state.idleResidency[i] = 0.0;
+            continue;
+        }
+
+        // Cumulative microseconds in this state
+        const quint64 time = quint64(value);
+        const quint64 delta = time >= previous[i] ? time - previous[i] : 0;
+        previous[i] = time;
+
+        state.idleResidency[i] = haveInterval ? qMin(100.0, delta / (elapsedSec * 1e6) * 100.0) : 0.0;
+        state.idleTotal += state.idleResidency[i];
+    }
+
+    state.idleTotal = qMin(100.0, state.idleTotal);
+}
@@ -0,0 +1,91 @@
+#ifndef COREPOWERTRACKER_H
+#define COREPOWERTRACKER_H
+
+#include "../core/procfilereader.h"
+#include "../core/sampletime.h"
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// Frequency and C-state picture of one logical CPU over the last interval
+struct CorePowerState {
+    static const int MAX_IDLE_STATES = 10;     // CPUIDLE_STATE_MAX
+
+    int cpu = 0;
+    double frequency = 0.0;                 // scaling_cur_freq (MHz)
+    double averageFrequency = 0.0;          // Time-weighted from time_in_state (MHz)
+    double policyMaxFrequency = 0.0;        // scaling_max_freq (MHz)
+    double hardwareMaxFrequency = 0.0;      // cpuinfo_max_freq (MHz)
+    QString governor;
+
+    // Percent of the interval spent in each cpuidle state, same order as
+    // CorePowerTracker::idleStateNames()
+    int idleStateCount = 0;
+    double idleResidency[MAX_IDLE_STATES] = {};
+    double idleTotal = 0.0;                 // Sum over all states
+
+    // Policy limit below what the hardware can do (thermal/power capping)
+    bool capped() const {
+        return policyMaxFrequency > 0.0 && policyMaxFrequency < hardwareMaxFrequency;
+    }
+};
+
+// Per-core cpufreq and cpuidle tracking. Files are found once by discover()
+// and then re-read through open descriptors - about ten per core, so a
+// 256-core box costs a few thousand pread() calls and no open()/close().
+class CorePowerTracker
+{
+public:
+    CorePowerTracker();
+    ~CorePowerTracker();
+
+    // Locate the files of cpu0..coreCount-1; call again after hotplug
+    void discover(int coreCount);
+
+    int coreCount() const {
+        return m_cores.size();
+    }
+
+    // cpuidle driver state names ("POLL", "C1", "C6" ...) and exit latencies
+    const QStringList &idleStateNames() const {
+        return m_idleStateNames;
+    }
+    const QVector<int> &idleStateLatencies() const {
+        return m_idleStateLatencies;
+    }
+
+    // Read every core; residencies cover the time since the previous call.
+    // states must have coreCount() entries and is updated in place.
+    void sample(QVector<CorePowerState> &states);
+
+private:
+    struct CoreFiles {
+        ProcFileReader currentFrequency;
+        ProcFileReader policyMaxFrequency;
+        ProcFileReader governor;
+        ProcFileReader timeInState;
+        QVector<ProcFileReader *> idleTime;
+
+        double hardwareMaxFrequency = 0.0;  // Fixed - read at discovery
+        QByteArray governorBytes;           // Governor is rarely changed - compare raw bytes
+        QVector<quint64> stateFrequencies;  // time_in_state rows (kHz)
+        QVector<quint64> stateTimes;        // 10 ms units, previous sample
+        QVector<quint64> idleTimes;         // Microseconds, previous sample
+
+        ~CoreFiles();
+    };
+
+    void sampleFrequency(CoreFiles &files, CorePowerState &state, double elapsedSec);
+    void sampleIdle(CoreFiles &files, CorePowerState &state, double elapsedSec);
+
+    QVector<CoreFiles *> m_cores;
+    QStringList m_idleStateNames;
+    QVector<int> m_idleStateLatencies;
+    SampleTime m_previousTime;
+
+    // Disable copy constructor/assignment - owns descriptors
+    CorePowerTracker(const CorePowerTracker &) = delete;
+    CorePowerTracker &operator=(const CorePowerTracker &) = delete;
+};
+
+#endif // COREPOWERTRACKER_H
@@ -1,25 +1,27 @@
 #include "cpumonitor.h"
 #include "../core/constants.h"
+#include "../controller/datacontroller.h"
 #include "../core/systemUtils.h"
+#include "../core/cpuusagekernel.h"
 #include <QDebug>
 #include <QDir>
 #include <QDirIterator>
 
-// static member definitions
-const QString CPUMonitor::THERMAL_ZONE_PATH = "/sys/class/thermal/thermal_zone0/temp";
-const QString CPUMonitor::CPUFREQ_PATH = "/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq";
-
-CPUMonitor::CPUMonitor(QObject *parent) : BaseMonitor(parent)
+CPUMonitor::CPUMonitor(QObject *parent)
+    : BaseMonitor(parent)
+    , m_statReader(Constants::PROC_STAT)
 {
     // Parse static info once (model, core count)
     parseProcCpuinfo();
+    m_cpuData = m_sample;
 
-    qDebug() << "CPUMonitor initialized - Model: " <<m_cpuData.model << "Cores: " << m_cpuData.coreCount;
+    qDebug() << "CPUMonitor initialized - Model: " <<m_sample.model << "Cores: " << m_sample.coreCount;
 }
 
-void CPUMonitor::clearHistory()
+CPUMonitor::~CPUMonitor()
 {
-    m_usageHistory.clear();
+    // Drain the sampler before our members go away
+    stop();
 }
 
 void CPUMonitor::collectData()
@@ -30,8 +32,7 @@ void CPUMonitor::collectData()
     success &= parseProcStat();
 
     // Parse optional data (may fail on sme systems)
-    parseTemperature();  // Don't fail if temperature unavailable
-    parseFrequency();    // Don't fail if frequency unavailable
+    sampleCorePower();   // Don't fail if cpufreq/cpuidle unavailable
 
     if (!success) {
         throw std::runtime_error("Failed to parse CPU data");
@@ -39,66 +40,76 @@ void CPUMonitor::collectData()
 
     // Calculate usage from parsed data
     double newUsage = calculateUsage();
-    m_cpuData.usage = newUsage;
+    m_sample.usage = newUsage;
+
+    calculatePerCoreUsage();
 
-    // Add to history
-    addToHistory(newUsage);
+    // Hand an immutable copy to the GUI thread
+    const CPUData snapshot = m_sample;
+    publish([this, snapshot]() {
+        m_cpuData = snapshot;
 
-    // Emit specific signal với detailed data
-    emit cpuDataUpdated(m_cpuData);
+        // Emit specific signal với detailed data
+        emit cpuDataUpdated(m_cpuData);
+        if (!m_cpuData.perCoreUsage.isEmpty()) {
+            emit perCoreUsageUpdated(m_cpuData.perCoreUsage);
+        }
+    });
 
-    qDebug() << "CPU Usage:" << m_cpuData.usage << "% Temp:" << m_cpuData.temperature << "°C";
+    qDebug() << "CPU Usage:" << m_sample.usage << "% Freq:" << m_sample.frequency << "MHz";
+}
+
+void CPUMonitor::appendMetrics(MetricSample &sample) const
+{
+    sample.values.insert("cpu.usage", m_sample.usage);
+    sample.values.insert("cpu.frequency", m_sample.frequency);
+    sample.values.insert("cpu.frequency_max", m_sample.maxFrequency);
+    sample.values.insert("cpu.capped_cores", m_sample.cappedCores);
+    sample.values.insert("cpu.idle_residency", m_sample.idleResidency);
 }
 
 bool CPUMonitor::parseProcStat()
 {
-    if (!SystemUtils::fileExits(Constants::PROC_STAT)) {
+    m_sample.timestamp = SampleTime::now();
+
+    if (!m_statReader.open()) {
         // Development on Windows - use fake data
-        m_cpuData.totalTime = 1000000;
-        m_cpuData.idleTime = 600000;    // 40% usage
+        m_sample.totalTime = 1000000;
+        m_sample.idleTime = 600000;    // 40% usage
         return true;
     }
 
-    QString content = SystemUtils::readFile(Constants::PROC_STAT);
+    ByteView content = m_statReader.read();
+    m_sample.timestamp = SampleTime::now();
     if (content.isEmpty()) {
         return false;
     }
 
-    // Parse first line: "cpu user nice system idle iowait irq softirq steal
-    QStringList lines = content.split('\n');
-    if (lines.isEmpty()) {
+    if (!ProcStatParser::parse(content, m_sample.stat,
+                               m_coreTotal.data(), m_coreIdle.data(), m_coreTotal.size())) {
         return false;
     }
 
-    QString cpuLine = lines.first();
-    if (!cpuLine.startsWith("cpu ")) {
-        return false;
+    // Core set changed (first run or hotplug) - resize and parse the same bytes again
+    if (m_sample.stat.coreCount != m_coreTotal.size()) {
+        resizeCoreArrays(m_sample.stat.coreCount);
+        ProcStatParser::parse(content, m_sample.stat,
+                              m_coreTotal.data(), m_coreIdle.data(), m_coreTotal.size());
     }
 
-    QStringList values = cpuLine.split(' ', Qt::SkipEmptyParts);
-    if (values.size() < 5) {
-        return false;
+    if (m_sample.stat.coreCount > 0) {
+        m_sample.coreCount = m_sample.stat.coreCount;
     }
 
-    // Extract CPU time values (all in clock ticks)
-    qint64 user = SystemUtils::parseInt64(values[1]);
-    qint64 nice = SystemUtils::parseInt64(values[2]);
-    qint64 system = SystemUtils::parseInt64(values[3]);
-    qint64 idle = SystemUtils::parseInt64(values[4]);
-    qint64 iowait = values.size() > 5 ? SystemUtils::parseInt64(values[5]) : 0;
-    qint64 irq = values.size() > 6 ? SystemUtils::parseInt64(values[6]) : 0;
-    qint64 softirq = values.size() > 7 ? SystemUtils::parseInt64(values[7]) : 0;
-
     // Calculate totals
-    qint64 idleTotal = idle + iowait;   // Total idle time
-    qint64 nonIdleTotal = user + nice + system + irq + softirq; // Active time
-    qint64 total = idleTotal + nonIdleTotal;   // Total time
+    qint64 idleTotal = m_sample.stat.cpu.idleTotal();  // Total idle time
+    qint64 total = m_sample.stat.cpu.total();          // Total time, incl. steal
 
     // Store for usage calculation
-    m_cpuData.lastTotalTime = m_cpuData.totalTime;
-    m_cpuData.lastIdleTime = m_cpuData.idleTime;
-    m_cpuData.totalTime = total;
-    m_cpuData.idleTime = idleTotal;
+    m_sample.lastTotalTime = m_sample.totalTime;
+    m_sample.lastIdleTime = m_sample.idleTime;
+    m_sample.totalTime = total;
+    m_sample.idleTime = idleTotal;
 
     return true;
 }
@@ -107,8 +118,8 @@ bool CPUMonitor::parseProcCpuinfo()
 {
     if(SystemUtils::fileExits(Constants::PROC_CPUINFO)) {
         // Devlopment fallback
-        m_cpuData.model = "Unknown CPU";
-        m_cpuData.coreCount = 1;
+        m_sample.model = "Unknown CPU";
+        m_sample.coreCount = 1;
         return true;
     }
 
@@ -129,74 +140,61 @@ bool CPUMonitor::parseProcCpuinfo()
         }
     }
 
-    m_cpuData.coreCount = qMax(coreCount, 1); // At least 1 core
+    m_sample.coreCount = qMax(coreCount, 1); // At least 1 core
     if (!model.isEmpty()) {
-        m_cpuData.model = model;
+        m_sample.model = model;
     }
     else {
-        m_cpuData.model = "Unknown CPU";
+        m_sample.model = "Unknown CPU";
     }
 
     return true;
 }
 
-bool CPUMonitor::parseTemperature()
+void CPUMonitor::sampleCorePower()
 {
-    if (!SystemUtils::fileExits(THERMAL_ZONE_PATH)) {
-        m_cpuData.temperature = 0.0; // Unknown
-        return false;
+    if (m_powerTracker.coreCount() == 0) {
+        m_sample.frequency = 0.0;  // Unknown
+        return;
     }
 
-    QString tempStr = SystemUtils::readFile(THERMAL_ZONE_PATH).trimmed();
-    if (tempStr.isEmpty()) {
-        return false;
-    }
+    m_powerTracker.sample(m_sample.cores);
 
-    bool ok;
-    qint64 tempMilliC = SystemUtils::parseInt64(tempStr, &ok);
-    if (!ok) {
-        return false;
-    }
-
-    // Convert millidegrees to degrees Celsius
-    m_cpuData.temperature = tempMilliC / 1000.0;
+    double frequencySum = 0.0;
+    double idleSum = 0.0;
+    double maxFrequency = 0.0;
+    int frequencyCores = 0;
+    int capped = 0;
 
-    return true;
-}
-
-bool CPUMonitor::parseFrequency()
-{
-    if (!SystemUtils::fileExits(CPUFREQ_PATH)) {
-        m_cpuData.frequency = 0.0;  // Unknown
-        return false;
-    }
-
-    QString freqStr = SystemUtils::readFile(CPUFREQ_PATH).trimmed();
-    if (freqStr.isEmpty()) {
-        return false;
-    }
-
-    bool ok;
-    qint64 freqKHz = SystemUtils::parseInt64(freqStr, &ok);
-    if (!ok) {
-        return false;
+    for (const CorePowerState &core : m_sample.cores) {
+        // Offline cores and cores without cpufreq read as 0 - leave them out
+        if (core.frequency > 0.0) {
+            frequencySum += core.frequency;
+            ++frequencyCores;
+        }
+        idleSum += core.idleTotal;
+        maxFrequency = qMax(maxFrequency, core.frequency);
+        if (core.capped()) {
+            ++capped;
+        }
     }
 
-    // Convert KHz to MHz
-    m_cpuData.frequency = freqKHz / 1000.0;
-
-    return true;
+    const int count = m_sample.cores.size();
+    m_sample.frequency = frequencyCores > 0 ? frequencySum / frequencyCores : 0.0;
+    m_sample.maxFrequency = maxFrequency;
+    m_sample.idleResidency = idleSum / count;
+    m_sample.cappedCores = capped;
 }
 
 double CPUMonitor::calculateUsage()
 {
-    if (m_cpuData.lastTotalTime == 0) {
+    if (m_sample.lastTotalTime == 0) {
         return 0.0;
     }
 
     // Calucate time differences
-    qint64 totalDiff = m_cpuData.totalTime - m_cpuData.lastTotalTime;
-    qint64 idleDiff = m_cpuData.idleTime - m_cpuData.lastIdleTime;
+    qint64 totalDiff = m_sample.totalTime - m_sample.lastTotalTime;
+    qint64 idleDiff = m_sample.idleTime - m_sample.lastIdleTime;
 
     if (totalDiff <= 0) {
         return 0.0;  // Avoid division by zero
@@ -209,13 +207,39 @@ double CPUMonitor::calculateUsage()
     return qMax(0.0, qMin(100.0, usage));
 }
 
-void CPUMonitor::addToHistory(double usage)
+void CPUMonitor::calculatePerCoreUsage()
 {
-    m_usageHistory.append(usage);
+    if (m_coreTotal.isEmpty()) {
+        m_sample.perCoreUsage.clear();
+        return;
+    }
 
-    // Maintain fixed-size history
-    while (m_usageHistory.size() > MAX_HISTORY_SIZE) {
-        m_usageHistory.removeFirst();
+    if (!m_havePreviousCores) {
+        // First sample - no interval yet, report 0% like calculateUsage()
+        m_prevCoreTotal = m_coreTotal;
+        m_prevCoreIdle = m_coreIdle;
+        m_havePreviousCores = true;
     }
+
+    // Written in place - detaches from the last published snapshot only
+    CpuUsageKernel::computeUsage(m_coreTotal.constData(), m_coreIdle.constData(),
+                                 m_prevCoreTotal.data(), m_prevCoreIdle.data(),
+                                 m_sample.perCoreUsage.data(), m_coreTotal.size());
 }
 
+void CPUMonitor::resizeCoreArrays(int coreCount)
+{
+    m_coreTotal.fill(0, coreCount);
+    m_coreIdle.fill(0, coreCount);
+    m_prevCoreTotal.fill(0, coreCount);
+    m_prevCoreIdle.fill(0, coreCount);
+    m_sample.perCoreUsage.fill(0.0, coreCount);
+    m_havePreviousCores = false;
+
+    // Hotplug changes the cpufreq/cpuidle file set too
+    m_powerTracker.discover(coreCount);
+    m_sample.cores.fill(CorePowerState(), coreCount);
+    m_sample.idleStateNames = m_powerTracker.idleStateNames();
+
+    qDebug() << "CPUMonitor tracking" << coreCount << "cores";
+}
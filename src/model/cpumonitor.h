@@ -2,12 +2,18 @@
 #define CPUMONITOR_H
 
 #include "base/basemonitor.h"
+#include "../core/procfilereader.h"
+#include "../core/procstatparser.h"
+#include "../core/sampletime.h"
+#include "corepowertracker.h"
 #include <QVector>
 
 struct CPUData {
     double usage = 0.0;           // CPU usage percentage (0-100)
-    double temperature = 0.0;     // CPU temperature in Celsius
-    double frequency = 0.0;       // CPU frequency in MHz
+    double frequency = 0.0;       // Mean current frequency over all cores (MHz)
+    double maxFrequency = 0.0;    // Fastest core right now (MHz)
+    int cappedCores = 0;          // Cores whose policy max is below the hardware max
+    double idleResidency = 0.0;   // Mean percent of the interval in any C-state
     int coreCount = 1;            // Number of CPU cores
     QString model;                // CPU model name
 
@@ -17,6 +23,19 @@ struct CPUData {
     qint64 lastTotalTime = 0;    // Previous total time
     qint64 lastIdleTime = 0;     // Previous idle time
 
+    // Taken at the /proc/stat read
+    SampleTime timestamp;
+
+    // Full /proc/stat snapshot (jiffies, ctxt, btime, process counters)
+    ProcStatData stat;
+
+    // Per-core usage percentages, indexed by cpuN (0-100)
+    QVector<double> perCoreUsage;
+
+    // Per-core frequency/governor/C-state residency, indexed by cpuN
+    QVector<CorePowerState> cores;
+    QStringList idleStateNames;   // Column names for CorePowerState::idleResidency
+
     bool isValid() const {
         return totalTime > 0;
     }
@@ -28,6 +47,7 @@ class CPUMonitor : public BaseMonitor
 
 public:
     explicit CPUMonitor(QObject *parent = nullptr);
+    ~CPUMonitor() override;
 
     // Returns const reference - read-only access
     const CPUData &data() const {
@@ -36,52 +56,55 @@ public:
     double usage() const {
         return m_cpuData.usage;
     }
-    double temperature() const {
-        return m_cpuData.temperature;
-    }
     double frequency() const {
         return m_cpuData.frequency;
     }
     QString model() const {
         return m_cpuData.model;
     }
-
-    // History tracking
-    QVector<double> usageHistory() const {
-        return m_usageHistory;
+    const QVector<double> &perCoreUsage() const {
+        return m_cpuData.perCoreUsage;
+    }
+    const QVector<CorePowerState> &cores() const {
+        return m_cpuData.cores;
     }
-
-    void clearHistory();
 
 signals:
     void cpuDataUpdated(const CPUData &data);
+    void perCoreUsageUpdated(const QVector<double> &usage);
 
 protected:
-    // Parse /proc/stat và calculate CPU usage
+    // Parse /proc/stat và calculate CPU usage (sampler thread)
     void collectData() override;
+    void appendMetrics(MetricSample &sample) const override;
 
 private:
     // Extract CPU time values
     bool parseProcStat();
     // Get CPU model, core count
     bool parseProcCpuinfo();
-    // Get CPU temperature
-    bool parseTemperature();
-    // Get current CPU frequency
-    bool parseFrequency();
+    // Per-core frequency and idle residency, plus the summary fields
+    void sampleCorePower();
     // Using current and previous time values
     double calculateUsage();
-    // Maintain fixed-size history buffer
-    void addToHistory(double usage);
+    // All cores in one pass over the SoA counters
+    void calculatePerCoreUsage();
+    void resizeCoreArrays(int coreCount);
 
 private:
-    CPUData m_cpuData;                    // Current CPU data
-    QVector<double> m_usageHistory;       // Usage history for charts
-    const int MAX_HISTORY_SIZE = 60;      // Keep 60 data points (1 minute)
+    CPUData m_cpuData;                    // Published CPU data (GUI thread)
+    CPUData m_sample;                     // Working copy (sampler thread)
+
+    // Per-core jiffy counters, structure-of-arrays indexed by cpuN
+    QVector<quint64> m_coreTotal;
+    QVector<quint64> m_coreIdle;
+    QVector<quint64> m_prevCoreTotal;
+    QVector<quint64> m_prevCoreIdle;
+    bool m_havePreviousCores = false;
 
-    // File paths for different data sources
-    static const QString THERMAL_ZONE_PATH;
-    static const QString CPUFREQ_PATH;
+    // Persistent descriptors, re-read with pread() every tick
+    ProcFileReader m_statReader;
+    CorePowerTracker m_powerTracker;
 };
 
 #endif // CPUMONITOR_H
@@ -0,0 +1,99 @@
+#include "linkwatcher.h"
+#include <QSocketNotifier>
+#include <QDebug>
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+namespace {
+    const int RECEIVE_BUFFER_SIZE = 16 * 1024;
+}
+
+LinkWatcher::LinkWatcher(QObject *parent)
+    : QObject(parent)
+{
+}
+
+LinkWatcher::~LinkWatcher()
+{
+    close();
+}
+
+bool LinkWatcher::open()
+{
+    if (m_fd >= 0) {
+        return true;    // Already open
+    }
+
+    m_fd = ::socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_ROUTE);
+    if (m_fd < 0) {
+        qDebug() << "Cannot open link notification socket:" << std::strerror(errno);
+        return false;
+    }
+
+    sockaddr_nl local;
+    std::memset(&local, 0, sizeof(local));
+    local.nl_family = AF_NETLINK;
+    local.nl_groups = RTMGRP_LINK;
+    if (::bind(m_fd, reinterpret_cast<sockaddr *>(&local), sizeof(local)) < 0) {
+        qDebug() << "Cannot subscribe to link notifications:" << std::strerror(errno);
+        close();
+        return false;
+    }
+
+    m_buffer.resize(RECEIVE_BUFFER_SIZE);
+
+    m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &LinkWatcher::onActivated);
+
+    qDebug() << "Subscribed to rtnetlink link notifications";
+    return true;
+}
+
+void LinkWatcher::close()
+{
+    delete m_notifier;
+    m_notifier = nullptr;
+
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+void LinkWatcher::onActivated()
+{
+    bool changed = false;
+
+    // Drain everything queued so a burst of link events costs one rescan
+    for (;;) {
+        ssize_t received = ::recv(m_fd, m_buffer.data(), m_buffer.size(), 0);
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == ENOBUFS) {
+                changed = true;     // Overrun - events lost, force a resync
+                continue;
+            }
+            break;  // EAGAIN - drained
+        }
+
+        int remaining = int(received);
+        for (const nlmsghdr *message = reinterpret_cast<const nlmsghdr *>(m_buffer.constData());
+             NLMSG_OK(message, remaining);
+             message = NLMSG_NEXT(message, remaining)) {
+            if (message->nlmsg_type == RTM_NEWLINK || message->nlmsg_type == RTM_DELLINK) {
+                changed = true;
+            }
+        }
+    }
+
+    if (changed) {
+        emit linksChanged();
+    }
+}
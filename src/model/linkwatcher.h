@@ -0,0 +1,40 @@
+#ifndef LINKWATCHER_H
+#define LINKWATCHER_H
+
+#include <QObject>
+#include <QByteArray>
+
+class QSocketNotifier;
+
+// Listens for RTMGRP_LINK notifications on an rtnetlink socket so interface
+// discovery only runs when the kernel reports a link change. Lives on the
+// sampler thread; open() must be called from there so the notifier is
+// registered with that thread's event loop.
+class LinkWatcher : public QObject
+{
+    Q_OBJECT
+public:
+    explicit LinkWatcher(QObject *parent = nullptr);
+    ~LinkWatcher();
+
+    bool open();
+    void close();
+
+    bool isOpen() const {
+        return m_fd >= 0;
+    }
+
+signals:
+    // One emission per batch of RTM_NEWLINK/RTM_DELLINK (or after an overrun)
+    void linksChanged();
+
+private slots:
+    void onActivated();
+
+private:
+    int m_fd = -1;
+    QSocketNotifier *m_notifier = nullptr;
+    QByteArray m_buffer;    // Reused receive buffer
+};
+
+#endif // LINKWATCHER_H
@@ -1,17 +1,20 @@
 #include "memorymonitor.h"
 #include "../core/constants.h"
+#include "../controller/datacontroller.h"
 #include "../core/systemUtils.h"
 #include <QDebug>
 
 MemoryMonitor::MemoryMonitor(QObject *parent)
     : BaseMonitor{parent}
+    , m_meminfoReader(Constants::PROC_MEMINFO)
 {
     qDebug() << "Memory Monitor initialized";
 }
 
-void MemoryMonitor::clearHistory()
+MemoryMonitor::~MemoryMonitor()
 {
-    m_usageHistory.clear();
+    // Drain the sampler before our members go away
+    stop();
 }
 
 void MemoryMonitor::collectData()
@@ -23,112 +26,95 @@ void MemoryMonitor::collectData()
     }
 
     calculatePercentages();
-    addToHistory(m_memoryData.usagePercentage);
 
-    emit memoryDataUpdated(m_memoryData);
+    // Hand an immutable copy to the GUI thread
+    const MemoryData snapshot = m_sample;
+    publish([this, snapshot]() {
+        m_memoryData = snapshot;
 
-    qDebug() << "Memory Usage:" << m_memoryData.usagePercentage
-             << "% Total:" << formatBytes(m_memoryData.totalMemory);
+        emit memoryDataUpdated(m_memoryData);
+    });
+
+    qDebug() << "Memory Usage:" << m_sample.usagePercentage
+             << "% Total:" << formatBytes(m_sample.totalMemory);
+}
+
+void MemoryMonitor::appendMetrics(MetricSample &sample) const
+{
+    sample.values.insert("memory.usage", m_sample.usagePercentage);
+    sample.values.insert("memory.swap", m_sample.swapPercentage);
+    sample.values.insert("memory.commit", m_sample.commitPercentage);
+    sample.values.insert("memory.dirty", m_sample.dirty);
 }
 
 
 bool MemoryMonitor::parseProcMeminfo()
 {
-    if (!SystemUtils::fileExits(Constants::PROC_MEMINFO)) {
+    m_sample.timestamp = SampleTime::now();
+
+    if (!m_meminfoReader.open()) {
         // Development fallback - fakedata
-        m_memoryData.totalMemory = 4LL * 1024 * 1024 * 1024;    // 4GB
-        m_memoryData.availableMemory = 1LL * 1024 * 1024 * 1024; // 1GB available
-        m_memoryData.usedMemory = m_memoryData.totalMemory - m_memoryData.availableMemory;
+        m_sample.totalMemory = 4LL * 1024 * 1024 * 1024;    // 4GB
+        m_sample.availableMemory = 1LL * 1024 * 1024 * 1024; // 1GB available
+        m_sample.usedMemory = m_sample.totalMemory - m_sample.availableMemory;
         return true;
     }
 
-    QStringList lines = SystemUtils::readFileLines(Constants::PROC_MEMINFO);
+    ByteView content = m_meminfoReader.read();
+    m_sample.timestamp = SampleTime::now();
+    if (content.isEmpty()) {
+        return false;
+    }
 
     // Parse memory information from /proc/meminfo
     // Format: "MemTotal:        1024000 kB"
-    for (const QString &line : lines) {
-        QStringList parts = line.split(':', Qt::SkipEmptyParts);
-        if (parts.size() < 2) {
-            continue;
-        }
-
-        QString key = parts[0].trimmed();
-        QString valueStr = parts[1].trimmed();
-
-        // Extract number value (remove " kB" suffix)
-        QStringList valueParts = valueStr.split(' ', Qt::SkipEmptyParts);
-        if (valueParts.isEmpty()) {
-            continue;
-        }
-
-        bool ok;
-        qint64 valueKB = SystemUtils::parseInt64(valueParts[0], &ok);
-        if (!ok) {
-            continue;
-        }
-
-        qint64 valueBytes = valueKB * 1024; // Convert KB to bytes
-
-        // Parse different memory types
-        if (key == "MemTotal") {
-            m_memoryData.totalMemory = valueBytes;
-        }
-        else if (key == "MemAvailable") {
-            m_memoryData.availableMemory = valueBytes;
-        }
-        else if (key == "MemFree") {
-            m_memoryData.freeMemory = valueBytes;
-        }
-        else if (key == "Buffers") {
-            m_memoryData.buffers = valueBytes;
-        }
-        else if (key == "Cached") {
-            m_memoryData.cached = valueBytes;
-        }
-        else if (key == "SwapTotal") {
-            m_memoryData.totalSwap = valueBytes;
-        }
-        else if (key == "SwapFree") {
-            m_memoryData.freeSwap = valueBytes;
-        }
+    if (!MeminfoParser::parse(content, m_sample.meminfo)) {
+        return false;
     }
 
+    const MeminfoData &info = m_sample.meminfo;
+    m_sample.totalMemory = info.value(MeminfoData::MemTotal);
+    m_sample.availableMemory = info.value(MeminfoData::MemAvailable);
+    m_sample.freeMemory = info.value(MeminfoData::MemFree);
+    m_sample.buffers = info.value(MeminfoData::Buffers);
+    m_sample.cached = info.value(MeminfoData::Cached);
+    m_sample.totalSwap = info.value(MeminfoData::SwapTotal);
+    m_sample.freeSwap = info.value(MeminfoData::SwapFree);
+    m_sample.committed = info.value(MeminfoData::CommittedAS);
+    m_sample.commitLimit = info.value(MeminfoData::CommitLimit);
+    m_sample.dirty = info.value(MeminfoData::Dirty);
+    m_sample.writeback = info.value(MeminfoData::Writeback);
+
     // Calculate derived values
-    if (m_memoryData.totalSwap > 0) {
-        m_memoryData.usedSwap = m_memoryData.totalSwap - m_memoryData.freeSwap;
-    }
+    m_sample.usedSwap = m_sample.totalSwap - m_sample.freeSwap;
 
     // If MemAvailable not available, estimate it
-    if (m_memoryData.availableMemory == 0) {
-        m_memoryData.availableMemory = m_memoryData.freeMemory +
-                                       m_memoryData.buffers +
-                                       m_memoryData.cached;
+    if (m_sample.availableMemory == 0) {
+        m_sample.availableMemory = m_sample.freeMemory +
+                                       m_sample.buffers +
+                                       m_sample.cached;
     }
 
-    m_memoryData.usedMemory = m_memoryData.totalMemory - m_memoryData.availableMemory;
+    m_sample.usedMemory = m_sample.totalMemory - m_sample.availableMemory;
 
-    return m_memoryData.totalMemory > 0;
+    return m_sample.totalMemory > 0;
 }
 
 void MemoryMonitor::calculatePercentages()
 {
-    if (m_memoryData.totalMemory > 0) {
-        m_memoryData.usagePercentage = ((double)m_memoryData.usedMemory / m_memoryData.totalMemory) * 100.0;
-        m_memoryData.usagePercentage = qMax(0.0, qMin(100.0, m_memoryData.usagePercentage));
+    if (m_sample.totalMemory > 0) {
+        m_sample.usagePercentage = ((double)m_sample.usedMemory / m_sample.totalMemory) * 100.0;
+        m_sample.usagePercentage = qMax(0.0, qMin(100.0, m_sample.usagePercentage));
     }
 
-    if (m_memoryData.totalSwap > 0) {
-        m_memoryData.swapPercentage = ((double)m_memoryData.usedSwap / m_memoryData.totalSwap) * 100.0;
-        m_memoryData.swapPercentage = qMax(0.0, qMin(100.0, m_memoryData.swapPercentage));
+    if (m_sample.totalSwap > 0) {
+        m_sample.swapPercentage = ((double)m_sample.usedSwap / m_sample.totalSwap) * 100.0;
+        m_sample.swapPercentage = qMax(0.0, qMin(100.0, m_sample.swapPercentage));
     }
-}
-
-void MemoryMonitor::addToHistory(double usage)
-{
-    m_usageHistory.append(usage);
 
-    while (m_usageHistory.size() > MAX_HISTORY_SIZE) {
-        m_usageHistory.removeFirst();
+    // Not clamped - overcommit past the limit is what we want to see
+    if (m_sample.commitLimit > 0) {
+        m_sample.commitPercentage = ((double)m_sample.committed / m_sample.commitLimit) * 100.0;
     }
 }
 
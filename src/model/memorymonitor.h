@@ -2,6 +2,9 @@
 #define MEMORYMONITOR_H
 
 #include "base/basemonitor.h"
+#include "../core/procfilereader.h"
+#include "../core/meminfoparser.h"
+#include "../core/sampletime.h"
 #include <QObject>
 
 struct MemoryData {
@@ -18,9 +21,22 @@ struct MemoryData {
     qint64 usedSwap = 0;            // Used swap space
     qint64 freeSwap = 0;            // Free swap space
 
+    // Commit charge and writeback (capacity planning)
+    qint64 committed = 0;           // Committed_AS
+    qint64 commitLimit = 0;         // CommitLimit
+    qint64 dirty = 0;               // Waiting to be written back
+    qint64 writeback = 0;           // Being written back
+
+    // Every /proc/meminfo field from the same read
+    MeminfoData meminfo;
+
+    // Taken at the /proc/meminfo read
+    SampleTime timestamp;
+
     // Calculated percentages
     double usagePercentage = 0.0;   // Memory usage percentage
     double swapPercentage = 0.0;    // Swap usage percentage
+    double commitPercentage = 0.0;  // Committed_AS of CommitLimit (may exceed 100)
 
     bool isValid() const{
         return totalMemory > 0;
@@ -37,6 +53,7 @@ class MemoryMonitor : public BaseMonitor
     Q_OBJECT
 public:
     explicit MemoryMonitor(QObject *parent = nullptr);
+    ~MemoryMonitor() override;
 
     // Data access
     const MemoryData &data() const {
@@ -59,12 +76,13 @@ public:
         return m_memoryData.availableMemory;
     }
 
-    // History tracking
-    QVector<double> usageHistory() const {
-        return m_usageHistory;
+    double commitUsage() const {
+        return m_memoryData.commitPercentage;
     }
 
-    void clearHistory();
+    const MeminfoData &meminfo() const {
+        return m_memoryData.meminfo;
+    }
 
     static QString formatBytes(qint64 bytes);
 
@@ -73,17 +91,18 @@ signals:
 
 protected:
     void collectData() override;
+    void appendMetrics(MetricSample &sample) const override;
 
 private:
     bool parseProcMeminfo();
 
     void calculatePercentages();
 
-    void addToHistory(double usage);
+    MemoryData m_memoryData;    // Published data (GUI thread)
+    MemoryData m_sample;        // Working copy (sampler thread)
 
-    MemoryData m_memoryData;
-    QVector<double> m_usageHistory;
-    const int MAX_HISTORY_SIZE = 60;
+    // Persistent /proc/meminfo descriptor
+    ProcFileReader m_meminfoReader;
 };
 
 #endif // MEMORYMONITOR_H
@@ -1,25 +1,65 @@
 #include "networkmonitor.h"
 #include "../core/constants.h"
+#include "../controller/datacontroller.h"
 #include "../core/systemUtils.h"
+#include "linkwatcher.h"
 #include <QDebug>
+#include <QHash>
 #include <QRandomGenerator>
+#include <cstring>
 
-NetworkMonitor::NetworkMonitor(QObject *parent) : BaseMonitor(parent)
+NetworkMonitor::NetworkMonitor(QObject *parent)
+    : BaseMonitor(parent)
+    , m_netDevReader(Constants::PROC_NET_DEV)
 {
     // Set update interval for network monitoring
     setUpdateInterval(Constants::NETWORK_UPDATE_INTERVAL);
 
-    // Find active network interface
+    // Find active network interface from one table read
+    readInterfaceTable();
     m_activeInterface = findActiveInterface();
+    m_activeIndex = indexOfInterface(m_activeInterface);
+    m_publishedData.activeInterface = m_activeInterface;
+    m_publishedData.interfaces = m_currentData.interfaces;
+
+    // Subscribe to link notifications on the sampler thread
+    m_linkWatcher = new LinkWatcher;
+    connect(m_linkWatcher, &LinkWatcher::linksChanged, m_linkWatcher, [this]() {
+        onLinksChanged();
+    });
+    moveToSampler(m_linkWatcher);
+
+    LinkWatcher *watcher = m_linkWatcher;
+    runOnSampler([this, watcher]() {
+        m_linkEvents = watcher->open();
+    });
+
+    qDebug() << "NetworkMonitor initialized - Active interface:" << m_activeInterface
+             << "Interfaces:" << m_counters.size();
+}
+
+NetworkMonitor::~NetworkMonitor()
+{
+    // Drain the sampler before our members go away
+    stop();
 
-    qDebug() << "NetworkMonitor initialized - Active interface:" << m_activeInterface;
+    LinkWatcher *watcher = m_linkWatcher;
+    runOnSampler([watcher]() {
+        delete watcher;
+    }, true);
 }
 
 void NetworkMonitor::collectData()
 {
     if (readNetworkStats()) {
         calculateSpeeds();
-        emit networkDataUpdated(m_currentData);
+
+        // Hand an immutable copy to the GUI thread
+        const NetworkData snapshot = m_currentData;
+        publish([this, snapshot]() {
+            m_publishedData = snapshot;
+            emit networkDataUpdated(m_publishedData);
+        });
 
         qDebug() << QString("Network: ↑%1 ↓%2 Interface: %3")
                         .arg(m_currentData.uploadSpeedFormatted())
@@ -28,10 +68,55 @@ void NetworkMonitor::collectData()
     }
 }
 
+void NetworkMonitor::appendMetrics(MetricSample &sample) const
+{
+    sample.values.insert("network.upload", m_currentData.uploadSpeed);
+    sample.values.insert("network.download", m_currentData.downloadSpeed);
+}
+
+bool NetworkMonitor::readInterfaceTable()
+{
+    // Binary counters from an RTM_GETSTATS dump (IFLA_STATS_LINK_64) - no
+    // text formatting or parsing
+    if (m_useNetlink) {
+        // Renames keep the ifindex, so only link notifications reveal them.
+        // Without those the names are re-read now and then, not every call -
+        // the full link dump costs more than /proc/net/dev.
+        if (!m_linkEvents) {
+            const SampleTime now = SampleTime::now();
+            if (!m_namesTime.isValid() ||
+                m_namesTime.secondsTo(now) * 1000.0 >= Constants::NETWORK_NAME_REFRESH_INTERVAL) {
+                m_netlink.invalidateNames();
+                m_namesTime = now;
+            }
+        }
+
+        bool ok = m_netlink.readAll(m_counters);
+        m_currentData.timestamp = SampleTime::now();
+        if (ok) {
+            syncInterfaceTable();
+            return true;
+        }
+
+        qDebug() << "rtnetlink unavailable - falling back to" << Constants::PROC_NET_DEV;
+        m_useNetlink = false;
+    }
+
+    ByteView bytes = m_netDevReader.read();
+    m_currentData.timestamp = SampleTime::now();
+    if (bytes.isEmpty()) {
+        return false;
+    }
+
+    NetDevParser::parse(bytes, m_counters);
+    syncInterfaceTable();
+
+    return true;
+}
+
 bool NetworkMonitor::readNetworkStats()
 {
-    QString content = SystemUtils::readFile(Constants::PROC_NET_DEV);
-    if (content.isEmpty()) {
+    if (!readInterfaceTable()) {
         // Fallback for non-Linux systems
         m_currentData.uploadSpeed = 0.5 + (QRandomGenerator::global()->bounded(20)) / 10.0;
         m_currentData.downloadSpeed = 2.0 + (QRandomGenerator::global()->bounded(50)) / 10.0;
@@ -39,63 +124,164 @@ bool NetworkMonitor::readNetworkStats()
         return true;
     }
 
-    QStringList lines = content.split('\n');
+    // Interface gone - pick a new one from the same table, no extra reads
+    if (m_activeIndex < 0) {
+        QString newInterface = findActiveInterface();
+        if (newInterface != m_activeInterface) {
+            m_activeInterface = newInterface;
+            qDebug() << "Network interface changed to:" << m_activeInterface;
+        }
+        m_activeIndex = indexOfInterface(m_activeInterface);
+    }
 
-    // Find line for active interface
-    for (const QString &line : lines) {
-        if (line.contains(m_activeInterface + ":")) {
-            QStringList parts = line.simplified().split(' ', Qt::SkipEmptyParts);
+    if (m_layoutChanged) {
+        m_layoutChanged = false;
+        announceInterfaces();
+    }
 
-            if (parts.size() >= 10) {
-                // /proc/net/dev format:
-                // interface: rx_bytes rx_packets ... tx_bytes tx_packets ...
-                qint64 rxBytes = parseNetworkValue(line, 1);  // Received bytes
-                qint64 txBytes = parseNetworkValue(line, 9);  // Transmitted bytes
+    if (m_activeIndex < 0) {
+        return false;
+    }
 
-                m_currentData.totalBytesDownloaded = rxBytes;
-                m_currentData.totalBytesUploaded = txBytes;
-                m_currentData.activeInterface = m_activeInterface;
+    const InterfaceCounters &active = m_counters.at(m_activeIndex);
+    m_currentData.totalBytesDownloaded = qint64(active.rxBytes);
+    m_currentData.totalBytesUploaded = qint64(active.txBytes);
+    m_currentData.activeInterface = m_activeInterface;
 
-                return true;
-            }
-        }
+    return true;
+}
+
+void NetworkMonitor::syncInterfaceTable()
+{
+    QVector<InterfaceStats> &table = m_currentData.interfaces;
+    const int count = m_counters.size();
+
+    // With link notifications the names are only compared after the kernel
+    // reported a change; a count mismatch always forces a rebuild
+    bool sameLayout = table.size() == count;
+    if (sameLayout && m_linkEvents && !m_linksDirty) {
+        return;
+    }
+    m_linksDirty = false;
+
+    for (int i = 0; sameLayout && i < count; ++i) {
+        sameLayout = std::strcmp(table[i].counters.name, m_counters[i].name) == 0;
+    }
+
+    if (sameLayout) {
+        return;     // Steady state - nothing to rebuild
+    }
+
+    // Carry previous counters over by name; new interfaces start from their
+    // current values so their first rate is 0
+    QHash<QByteArray, int> previousIndex;
+    for (int i = 0; i < table.size(); ++i) {
+        previousIndex.insert(QByteArray(table[i].counters.name), i);
+    }
+
+    QVector<InterfaceCounters> previous(count);
+    QVector<InterfaceStats> rebuilt(count);
+    for (int i = 0; i < count; ++i) {
+        int old = previousIndex.value(QByteArray(m_counters[i].name), -1);
+        previous[i] = old >= 0 ? m_previousCounters.value(old, m_counters[i]) : m_counters[i];
+        rebuilt[i].name = QString::fromLatin1(m_counters[i].name);
     }
 
-    // Interface not found, try to find new active interface
-    QString newInterface = findActiveInterface();
-    if (newInterface != m_activeInterface) {
-        m_activeInterface = newInterface;
-        qDebug() << "Network interface changed to:" << m_activeInterface;
-        // Reset previous values
-        m_previousRxBytes = 0;
-        m_previousTxBytes = 0;
+    m_previousCounters = previous;
+    table = rebuilt;
+    for (int i = 0; i < count; ++i) {
+        table[i].counters = m_counters[i];
     }
 
-    return false;
+    m_activeIndex = indexOfInterface(m_activeInterface);
+    m_layoutChanged = true;
+
+    qDebug() << "Network interface set changed -" << count << "interfaces";
+}
+
+void NetworkMonitor::onLinksChanged()
+{
+    // Compared on the next read, tick or not
+    m_linksDirty = true;
+    m_netlink.invalidateNames();
+
+    // Collect right away rather than read the table here: an extra read
+    // between ticks would seed new interfaces' previous counters and
+    // understate their first rate. Stopped monitors wait for start().
+    if (isRunning()) {
+        updateNow();
+    }
+}
+
+void NetworkMonitor::announceInterfaces()
+{
+    QStringList names;
+    for (const InterfaceStats &entry : m_currentData.interfaces) {
+        if (entry.name != "lo") {
+            names.append(entry.name);
+        }
+    }
+
+    const QString active = m_activeInterface;
+    QMetaObject::invokeMethod(this, [this, names, active]() {
+        m_publishedData.activeInterface = active;
+        emit interfacesChanged(names, active);
+    }, Qt::QueuedConnection);
+}
+
+int NetworkMonitor::indexOfInterface(const QString &interface) const
+{
+    const QVector<InterfaceStats> &table = m_currentData.interfaces;
+    for (int i = 0; i < table.size(); ++i) {
+        if (table[i].name == interface) {
+            return i;
+        }
+    }
+    return -1;
 }
 
 void NetworkMonitor::calculateSpeeds()
 {
-    QDateTime currentTime = QDateTime::currentDateTime();
+    QVector<InterfaceStats> &table = m_currentData.interfaces;
+    const int count = qMin(table.size(), m_counters.size());
 
-    if (m_previousTime.isValid() && m_previousRxBytes > 0 && m_previousTxBytes > 0) {
-        // Calculate time difference in seconds
-        qint64 timeDiffMs = m_previousTime.msecsTo(currentTime);
-        double timeDiffSec = timeDiffMs / 1000.0;
+    // Monotonic nanosecond interval between the two reads
+    const double timeDiffSec = m_previousTime.secondsTo(m_currentData.timestamp);
 
-        if (timeDiffSec > 0) {
-            // Calculate byte differences
-            qint64 rxDiff = m_currentData.totalBytesDownloaded - m_previousRxBytes;
-            qint64 txDiff = m_currentData.totalBytesUploaded - m_previousTxBytes;
+    // One pass over every interface
+    InterfaceStats *stats = table.data();
+    const InterfaceCounters *current = m_counters.constData();
+    InterfaceCounters *previous = m_previousCounters.data();
 
-            // Convert to MB/s
-            m_currentData.downloadSpeed = (rxDiff / timeDiffSec) / Constants::BYTES_PER_MB;
-            m_currentData.uploadSpeed = (txDiff / timeDiffSec) / Constants::BYTES_PER_MB;
+    for (int i = 0; i < count; ++i) {
+        InterfaceStats &entry = stats[i];
+        const InterfaceCounters &cur = current[i];
+        const InterfaceCounters &prev = previous[i];
 
-            // Clamp to reasonable values (0-1000 MB/s)
-            m_currentData.downloadSpeed = qMax(0.0, qMin(1000.0, m_currentData.downloadSpeed));
-            m_currentData.uploadSpeed = qMax(0.0, qMin(1000.0, m_currentData.uploadSpeed));
+        if (timeDiffSec > 0) {
+            entry.rxBytesRate = NetDevParser::counterDelta(cur.rxBytes, prev.rxBytes) / timeDiffSec;
+            entry.txBytesRate = NetDevParser::counterDelta(cur.txBytes, prev.txBytes) / timeDiffSec;
+            entry.rxPacketsRate = NetDevParser::counterDelta(cur.rxPackets, prev.rxPackets) / timeDiffSec;
+            entry.txPacketsRate = NetDevParser::counterDelta(cur.txPackets, prev.txPackets) / timeDiffSec;
+            entry.rxErrorsRate = NetDevParser::counterDelta(cur.rxErrors, prev.rxErrors) / timeDiffSec;
+            entry.txErrorsRate = NetDevParser::counterDelta(cur.txErrors, prev.txErrors) / timeDiffSec;
+            entry.rxDroppedRate = NetDevParser::counterDelta(cur.rxDropped, prev.rxDropped) / timeDiffSec;
+            entry.txDroppedRate = NetDevParser::counterDelta(cur.txDropped, prev.txDropped) / timeDiffSec;
         }
+
+        entry.counters = cur;
+        previous[i] = cur;
+    }
+
+    if (timeDiffSec > 0 && m_activeIndex >= 0 && m_activeIndex < count) {
+        // Convert to MB/s
+        const InterfaceStats &active = stats[m_activeIndex];
+        m_currentData.downloadSpeed = active.rxBytesRate / Constants::BYTES_PER_MB;
+        m_currentData.uploadSpeed = active.txBytesRate / Constants::BYTES_PER_MB;
+
+        // Clamp to reasonable values (0-1000 MB/s)
+        m_currentData.downloadSpeed = qMax(0.0, qMin(1000.0, m_currentData.downloadSpeed));
+        m_currentData.uploadSpeed = qMax(0.0, qMin(1000.0, m_currentData.uploadSpeed));
     }
     else {
         // First measuremen, no speed calculation possible
@@ -103,36 +289,27 @@ void NetworkMonitor::calculateSpeeds()
         m_currentData.uploadSpeed = 0.0;
     }
 
-    // Store current values for next calculation
-    m_previousRxBytes = m_currentData.totalBytesDownloaded;
-    m_previousTxBytes = m_currentData.totalBytesUploaded;
-    m_previousTime = currentTime;
+    // Store current time for next calculation
+    m_previousTime = m_currentData.timestamp;
 }
 
-QString NetworkMonitor::findActiveInterface()
+QString NetworkMonitor::findActiveInterface() const
 {
     // Check common interface names
     for (const QString &interface : Constants::NETWORK_INTERFACES) {
-        if (isValidInterface(interface)) {
+        if (indexOfInterface(interface) >= 0) {
             return interface;
         }
     }
 
-    // If no common interface found, try to detect from /proc/net/dev
-    QString content = SystemUtils::readFile(Constants::PROC_NET_DEV);
-    if (!content.isEmpty()) {
-        QStringList lines = content.split('\n');
+    // If no common interface found, take the first real one from the table
+    for (const InterfaceStats &entry : m_currentData.interfaces) {
+        const QString &interface = entry.name;
 
-        for (const QString &line : lines) {
-            if (line.contains(':')) {
-                QString interface = line.split(':').first().trimmed();
-
-                // Skip loopback and virtual interfaces
-                if (interface != "lo" && !interface.startsWith("docker") &&
-                    !interface.startsWith("vir") && isValidInterface(interface)) {
-                    return interface;
-                }
-            }
+        // Skip loopback and virtual interfaces
+        if (interface != "lo" && !interface.startsWith("docker") &&
+            !interface.startsWith("vir")) {
+            return interface;
         }
     }
 
@@ -140,42 +317,14 @@ QString NetworkMonitor::findActiveInterface()
     return "eth0";
 }
 
-bool NetworkMonitor::isValidInterface(const QString &interface)
-{
-    QString content = SystemUtils::readFile(Constants::PROC_NET_DEV);
-    return content.contains(interface + ":");
-}
-
-qint64 NetworkMonitor::parseNetworkValue(const QString &line, int position)
-{
-    QStringList parts = line.simplified().split(' ', Qt::SkipEmptyParts);
-
-    if (position < parts.size()) {
-        bool ok;
-        qint64 value = parts[position].toLongLong(&ok);
-        return ok ? value : 0;
-    }
-
-    return 0;
-}
-
 QStringList NetworkMonitor::availableInterfaces() const
 {
     QStringList interfaces;
 
-    QString content = SystemUtils::readFile(Constants::PROC_NET_DEV);
-    if (!content.isEmpty()) {
-        QStringList lines = content.split('\n');
-
-        for (const QString &line : lines) {
-            if (line.contains(':')) {
-                QString interface = line.split(':').first().trimmed();
-
-                // Skip loopback
-                if (interface != "lo") {
-                    interfaces.append(interface);
-                }
-            }
+    for (const InterfaceStats &entry : m_publishedData.interfaces) {
+        // Skip loopback
+        if (entry.name != "lo") {
+            interfaces.append(entry.name);
         }
     }
 
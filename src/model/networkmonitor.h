@@ -2,8 +2,29 @@
 #define NETWORKMONITOR_H
 
 #include "base/basemonitor.h"
+#include "../core/procfilereader.h"
+#include "../core/netdevparser.h"
+#include "../core/netlinkstats.h"
+#include "../core/sampletime.h"
 #include <QStringList>
-#include <QDateTime>
+#include <QVector>
+
+class LinkWatcher;
+
+// Counters and rates of one interface (rates in units per second)
+struct InterfaceStats
+{
+    QString name;
+    InterfaceCounters counters;
+    double rxBytesRate = 0.0;
+    double txBytesRate = 0.0;
+    double rxPacketsRate = 0.0;
+    double txPacketsRate = 0.0;
+    double rxErrorsRate = 0.0;
+    double txErrorsRate = 0.0;
+    double rxDroppedRate = 0.0;
+    double txDroppedRate = 0.0;
+};
 
 struct NetworkData
 {
@@ -13,6 +34,12 @@ struct NetworkData
     qint64 totalBytesUploaded = 0;
     qint64 totalBytesDownloaded = 0;
 
+    // Taken at the counter table read - rates divide by these intervals
+    SampleTime timestamp;
+
+    // Every interface from one table read (rtnetlink or /proc/net/dev)
+    QVector<InterfaceStats> interfaces;
+
     // Helper methods
     QString uploadSpeedFormatted() const {
         return QString::number(uploadSpeed, 'f', 1) + " MB/s";
@@ -28,45 +55,71 @@ class NetworkMonitor : public BaseMonitor
     Q_OBJECT
 public:
     explicit NetworkMonitor(QObject *parent = nullptr);
+    ~NetworkMonitor() override;
 
     // Current data access
     NetworkData currentData() const {
-        return m_currentData;
+        return m_publishedData;
+    }
+
+    // Per-interface counters and rates from the last sample
+    const QVector<InterfaceStats> &interfaceStats() const {
+        return m_publishedData.interfaces;
     }
 
     // Network interface management
     QString activeInterface() const {
-        return m_activeInterface;
+        return m_publishedData.activeInterface;
     }
     QStringList availableInterfaces() const;
 
 signals:
     void networkDataUpdated(const NetworkData &data);
+    // Interface set or active interface changed
+    void interfacesChanged(const QStringList &interfaces, const QString &activeInterface);
 
 protected:
     void collectData() override;
+    void appendMetrics(MetricSample &sample) const override;
 
 private:
     // Data collection
     bool readNetworkStats();
+    bool readInterfaceTable();
     void calculateSpeeds();
-    QString findActiveInterface();
-    qint64 parseNetworkValue(const QString &line, int position);
+    QString findActiveInterface() const;
 
-    // Network interface detection
-    bool isValidInterface(const QString &interface);
+    // Rebuild names and previous counters when the interface set changes
+    void syncInterfaceTable();
+    // Kernel reported a link change - collect right away (sampler thread)
+    void onLinksChanged();
+    // Queue interfacesChanged() with the current table (sampler thread)
+    void announceInterfaces();
+    int indexOfInterface(const QString &interface) const;
 
+    NetworkData m_publishedData;    // Published data (GUI thread)
+
+    // Working state below is only touched on the sampler thread
     NetworkData m_currentData;
-    NetworkData m_previousData;
     QString m_activeInterface;
+    int m_activeIndex = -1;
+
+    // Flat counter tables, same order as m_currentData.interfaces
+    QVector<InterfaceCounters> m_counters;
+    QVector<InterfaceCounters> m_previousCounters;
+    SampleTime m_previousTime;
 
-    // Previous values for speed calculation
-    qint64 m_previousRxBytes = 0;
-    qint64 m_previousTxBytes = 0;
-    QDateTime m_previousTime;
+    // Event-driven discovery; when unavailable every tick checks the layout
+    LinkWatcher *m_linkWatcher = nullptr;
+    bool m_linkEvents = false;
+    bool m_linksDirty = true;
+    bool m_layoutChanged = false;   // Table rebuilt since the last announcement
+    SampleTime m_namesTime;         // Last forced name reload without events
 
-    // Available interfaces cache
-    QStringList m_availableInterfaces;
+    // Counter backends: rtnetlink dump first, /proc/net/dev as fallback
+    NetlinkStats m_netlink;
+    bool m_useNetlink = true;
+    ProcFileReader m_netDevReader;
 };
 
 #endif // NETWORKMONITOR_H
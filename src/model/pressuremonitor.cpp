@@ -0,0 +1,178 @@
+#include "pressuremonitor.h"
+#include "../core/constants.h"
+#include "../controller/datacontroller.h"
+#include "../core/systemUtils.h"
+#include "pressurewatcher.h"
+#include <QDebug>
+#include <QFileInfo>
+
+PressureMonitor::PressureMonitor(QObject *parent)
+    : BaseMonitor(parent)
+{
+    setUpdateInterval(Constants::PRESSURE_UPDATE_INTERVAL);
+
+    const QString cgroup = findCgroup();
+    m_sample.system.name = "system";
+    m_sample.cgroup.name = cgroup;
+
+    for (int r = 0; r < PressureData::ResourceCount; ++r) {
+        const char *name = PressureData::resourceName(PressureData::Resource(r));
+        m_systemReaders[r].setPath(QString("%1/%2").arg(Constants::PROC_PRESSURE_DIR, name));
+        if (!cgroup.isEmpty()) {
+            m_cgroupReaders[r].setPath(QString("%1%2/%3.pressure").arg(Constants::SYS_CGROUP_DIR, cgroup, name));
+        }
+    }
+    m_pressureData = m_sample;
+
+    // Register triggers on the sampler thread
+    m_watcher = new PressureWatcher;
+    connect(m_watcher, &PressureWatcher::triggered, m_watcher, [this](int resource) {
+        onTriggered(resource);
+    });
+    moveToSampler(m_watcher);
+
+    PressureWatcher *watcher = m_watcher;
+    runOnSampler([this, watcher]() {
+        for (int r = 0; r < PressureData::ResourceCount; ++r) {
+            watcher->addTrigger(r, m_systemReaders[r].path(),
+                                Constants::PSI_TRIGGER_STALL_US, Constants::PSI_TRIGGER_WINDOW_US);
+        }
+        m_sample.triggersActive = watcher->triggerCount() > 0;
+    });
+
+    qDebug() << "PressureMonitor initialized - cgroup:" << (cgroup.isEmpty() ? QString("none") : cgroup);
+}
+
+PressureMonitor::~PressureMonitor()
+{
+    // Drain the sampler before our members go away
+    stop();
+
+    PressureWatcher *watcher = m_watcher;
+    runOnSampler([watcher]() {
+        delete watcher;
+    }, true);
+}
+
+QString PressureMonitor::findCgroup()
+{
+    // cgroup v2 entry is "0::/path"; the root cgroup has no pressure files
+    const QStringList lines = SystemUtils::readFileLines(Constants::PROC_SELF_CGROUP);
+    for (const QString &line : lines) {
+        if (!line.startsWith("0::")) {
+            continue;
+        }
+
+        const QString path = line.mid(3).trimmed();
+        if (path.isEmpty() || path == "/") {
+            return QString();
+        }
+        if (!QFileInfo::exists(Constants::SYS_CGROUP_DIR + path + "/cpu.pressure")) {
+            return QString();
+        }
+        return path;
+    }
+
+    return QString();
+}
+
+bool PressureMonitor::readStats(ProcFileReader &reader, PressureStats &stats)
+{
+    if (reader.path().isEmpty()) {
+        return false;
+    }
+
+    ByteView bytes = reader.read();
+    if (bytes.isEmpty()) {
+        stats = PressureStats();
+        return false;
+    }
+
+    return PsiParser::parse(bytes, stats);
+}
+
+void PressureMonitor::onTriggered(int resource)
+{
+    // Stopped monitors collect nothing, not even for a stall
+    if (!isRunning()) {
+        return;
+    }
+
+    // Sampler thread - collect now instead of waiting for the next tick
+    m_pendingStalls |= 1 << resource;
+    updateNow();
+}
+
+void PressureMonitor::collectData()
+{
+    m_sample.timestamp = SampleTime::now();
+
+    bool any = false;
+    any |= readStats(m_systemReaders[PressureData::Cpu], m_sample.system.cpu);
+    any |= readStats(m_systemReaders[PressureData::Memory], m_sample.system.memory);
+    any |= readStats(m_systemReaders[PressureData::Io], m_sample.system.io);
+    readStats(m_cgroupReaders[PressureData::Cpu], m_sample.cgroup.cpu);
+    readStats(m_cgroupReaders[PressureData::Memory], m_sample.cgroup.memory);
+    readStats(m_cgroupReaders[PressureData::Io], m_sample.cgroup.io);
+
+    if (!any) {
+        // Kernel without CONFIG_PSI or booted with psi=0 - nothing to report
+        m_pendingStalls = 0;
+        return;
+    }
+
+    int changedLevels = 0;
+    for (int r = 0; r < PressureData::ResourceCount; ++r) {
+        const PressureData::Resource resource = PressureData::Resource(r);
+        const double avg10 = m_sample.stats(m_sample.system, resource).some.avg10;
+
+        PressureData::Level level = PressureData::Normal;
+        if (avg10 >= Constants::PSI_CRITICAL_THRESHOLD) {
+            level = PressureData::Critical;
+        } else if (avg10 >= Constants::PSI_WARNING_THRESHOLD) {
+            level = PressureData::Warning;
+        }
+
+        if (level != m_sample.levels[r]) {
+            m_sample.levels[r] = level;
+            changedLevels |= 1 << r;
+        }
+        if (m_pendingStalls & (1 << r)) {
+            ++m_sample.stallEvents[r];
+        }
+    }
+
+    const int stalls = m_pendingStalls;
+    m_pendingStalls = 0;
+
+    // Hand an immutable copy to the GUI thread
+    const PressureData snapshot = m_sample;
+    publish([this, snapshot, stalls, changedLevels]() {
+        m_pressureData = snapshot;
+
+        for (int r = 0; r < PressureData::ResourceCount; ++r) {
+            const PressureData::Resource resource = PressureData::Resource(r);
+            if (changedLevels & (1 << r)) {
+                emit levelChanged(resource, m_pressureData.levels[r]);
+            }
+            if (stalls & (1 << r)) {
+                emit pressureStall(resource, m_pressureData);
+            }
+        }
+        emit pressureDataUpdated(m_pressureData);
+    });
+
+    if (stalls) {
+        qDebug() << "PSI stall - cpu" << m_sample.system.cpu.some.avg10
+                 << "memory" << m_sample.system.memory.some.avg10
+                 << "io" << m_sample.system.io.some.avg10;
+    }
+}
+
+void PressureMonitor::appendMetrics(MetricSample &sample) const
+{
+    sample.values.insert("pressure.cpu", m_sample.system.cpu.some.avg10);
+    sample.values.insert("pressure.memory", m_sample.system.memory.some.avg10);
+    sample.values.insert("pressure.memory_full", m_sample.system.memory.full.avg10);
+    sample.values.insert("pressure.io", m_sample.system.io.some.avg10);
+}
@@ -0,0 +1,108 @@
+#ifndef PRESSUREMONITOR_H
+#define PRESSUREMONITOR_H
+
+#include "base/basemonitor.h"
+#include "../core/procfilereader.h"
+#include "../core/psiparser.h"
+#include "../core/sampletime.h"
+
+class PressureWatcher;
+
+// PSI of one scope - the whole system or one cgroup
+struct PressureSource {
+    QString name;                   // "system" or the cgroup path
+    PressureStats cpu;
+    PressureStats memory;
+    PressureStats io;
+};
+
+struct PressureData {
+    enum Resource {
+        Cpu,
+        Memory,
+        Io,
+        ResourceCount
+    };
+
+    enum Level {
+        Normal,
+        Warning,
+        Critical
+    };
+
+    PressureSource system;
+    PressureSource cgroup;          // Our own cgroup (v2), empty name if none
+
+    // System "some" avg10 against the PSI thresholds in Constants
+    Level levels[ResourceCount] = { Normal, Normal, Normal };
+
+    // Trigger notifications since start
+    quint64 stallEvents[ResourceCount] = {};
+    bool triggersActive = false;
+
+    // Taken at the read
+    SampleTime timestamp;
+
+    const PressureStats &stats(const PressureSource &source, Resource resource) const {
+        return resource == Cpu ? source.cpu : resource == Memory ? source.memory : source.io;
+    }
+
+    Level worstLevel() const {
+        return qMax(levels[Cpu], qMax(levels[Memory], levels[Io]));
+    }
+
+    static const char *resourceName(Resource resource) {
+        return resource == Cpu ? "cpu" : resource == Memory ? "memory" : "io";
+    }
+};
+
+// Pressure Stall Information from /proc/pressure and our cgroup's
+// *.pressure files. Averages are sampled on the normal interval; stalls are
+// pushed by PSI triggers, which collect and publish right away.
+class PressureMonitor : public BaseMonitor
+{
+    Q_OBJECT
+public:
+    explicit PressureMonitor(QObject *parent = nullptr);
+    ~PressureMonitor() override;
+
+    // Data access
+    const PressureData &data() const {
+        return m_pressureData;
+    }
+
+    PressureData::Level level(PressureData::Resource resource) const {
+        return m_pressureData.levels[resource];
+    }
+
+signals:
+    void pressureDataUpdated(const PressureData &data);
+
+    // A PSI trigger fired - tasks stalled past the threshold within one window
+    void pressureStall(PressureData::Resource resource, const PressureData &data);
+
+    // Threshold crossed in either direction
+    void levelChanged(PressureData::Resource resource, PressureData::Level level);
+
+protected:
+    void collectData() override;
+    void appendMetrics(MetricSample &sample) const override;
+
+private:
+    static QString findCgroup();
+    static bool readStats(ProcFileReader &reader, PressureStats &stats);
+    void onTriggered(int resource);
+
+    PressureData m_pressureData;    // Published data (GUI thread)
+
+    // Working state below is only touched on the sampler thread
+    PressureData m_sample;
+    int m_pendingStalls = 0;        // Bit per resource, set by triggers
+
+    ProcFileReader m_systemReaders[PressureData::ResourceCount];
+    ProcFileReader m_cgroupReaders[PressureData::ResourceCount];
+
+    PressureWatcher *m_watcher = nullptr;
+};
+
+#endif // PRESSUREMONITOR_H
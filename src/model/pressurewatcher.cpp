@@ -0,0 +1,82 @@
+#include "pressurewatcher.h"
+#include "../core/constants.h"
+#include <QSocketNotifier>
+#include <QDebug>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+PressureWatcher::PressureWatcher(QObject *parent)
+    : QObject(parent)
+{
+}
+
+PressureWatcher::~PressureWatcher()
+{
+    clear();
+}
+
+int PressureWatcher::openTrigger(const QString &path, qint64 stallUs, qint64 windowUs)
+{
+    int fd = ::open(path.toLocal8Bit().constData(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+
+    // The trigger lives as long as the descriptor; the terminating NUL is
+    // part of the expected write
+    char spec[64];
+    const int length = std::snprintf(spec, sizeof(spec), "some %lld %lld",
+                                     (long long)stallUs, (long long)windowUs);
+    if (::write(fd, spec, length + 1) < 0) {
+        const int error = errno;
+        ::close(fd);
+        errno = error;
+        return -1;
+    }
+
+    return fd;
+}
+
+bool PressureWatcher::addTrigger(int id, const QString &path, qint64 stallUs, qint64 windowUs)
+{
+    int fd = openTrigger(path, stallUs, windowUs);
+
+    // Unprivileged triggers need a window that is a multiple of 2 s (6.5+);
+    // scale the stall threshold along so the ratio stays the same
+    if (fd < 0 && (errno == EPERM || errno == EACCES || errno == EINVAL) &&
+        windowUs < Constants::PSI_UNPRIVILEGED_WINDOW_US) {
+        const qint64 scaledStall = stallUs * Constants::PSI_UNPRIVILEGED_WINDOW_US / windowUs;
+        fd = openTrigger(path, scaledStall, Constants::PSI_UNPRIVILEGED_WINDOW_US);
+    }
+
+    if (fd < 0) {
+        qDebug() << "Cannot register PSI trigger on" << path << ":" << std::strerror(errno);
+        return false;
+    }
+
+    Trigger trigger;
+    trigger.id = id;
+    trigger.fd = fd;
+
+    // PSI signals events as POLLPRI - the Exception notifier type
+    trigger.notifier = new QSocketNotifier(fd, QSocketNotifier::Exception, this);
+    connect(trigger.notifier, &QSocketNotifier::activated, this, [this, id]() {
+        emit triggered(id);
+    });
+
+    m_triggers.append(trigger);
+    return true;
+}
+
+void PressureWatcher::clear()
+{
+    for (const Trigger &trigger : m_triggers) {
+        delete trigger.notifier;
+        ::close(trigger.fd);
+    }
+    m_triggers.clear();
+}
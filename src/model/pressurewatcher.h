@@ -0,0 +1,46 @@
+#ifndef PRESSUREWATCHER_H
+#define PRESSUREWATCHER_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+class QSocketNotifier;
+
+// Registers PSI triggers ("some 100000 1000000" = 100 ms stalled within a
+// 1 s window) on pressure files and waits for POLLPRI through socket
+// notifiers, so stall events arrive without any polling. Lives on the
+// sampler thread; addTrigger() must be called from there.
+class PressureWatcher : public QObject
+{
+    Q_OBJECT
+public:
+    explicit PressureWatcher(QObject *parent = nullptr);
+    ~PressureWatcher();
+
+    // One trigger per call, identified by id in triggered(). Falls back to
+    // the unprivileged minimum window when the kernel refuses ours.
+    bool addTrigger(int id, const QString &path, qint64 stallUs, qint64 windowUs);
+    void clear();
+
+    int triggerCount() const {
+        return m_triggers.size();
+    }
+
+signals:
+    // At most once per trigger window
+    void triggered(int id);
+
+private:
+    struct Trigger {
+        int id;
+        int fd;
+        QSocketNotifier *notifier;
+    };
+
+    static int openTrigger(const QString &path, qint64 stallUs, qint64 windowUs);
+
+    QVector<Trigger> m_triggers;
+};
+
+#endif // PRESSUREWATCHER_H
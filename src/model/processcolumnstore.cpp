@@ -0,0 +1,89 @@
+#include "processcolumnstore.h"
+
+namespace {
+    const quint32 ALL_COLUMNS = (1u << ProcessColumnStore::ColumnCount) - 1;
+
+    // Set the column bit when the value really changed
+    template <typename T>
+    inline void assign(T &field, const T &value, quint32 &changed, int column)
+    {
+        if (!(field == value)) {
+            field = value;
+            changed |= 1u << column;
+        }
+    }
+}
+
+void ProcessColumnStore::apply(const QVector<ProcessInfo> &processes,
+                               QVector<int> &added, QVector<int> &removed)
+{
+    ++m_currentGeneration;
+    added.resize(0);
+    removed.resize(0);
+
+    m_changed.fill(0, m_pid.size());
+
+    for (const ProcessInfo &process : processes) {
+        int row = m_rowOfPid.value(process.pid, -1);
+        quint32 changed = 0;
+
+        if (row < 0) {
+            row = allocateRow(process.pid);
+            added.append(row);
+            changed = ALL_COLUMNS;
+        }
+
+        assign(m_name[row], process.name, changed, NameColumn);
+        assign(m_state[row], process.state, changed, StateColumn);
+        assign(m_cpu[row], process.cpuUsage, changed, CpuColumn);
+        assign(m_rss[row], process.rss, changed, MemoryColumn);
+        assign(m_threads[row], process.threads, changed, ThreadsColumn);
+        assign(m_io[row], process.ioRate(), changed, IoColumn);
+
+        m_changed[row] = changed;
+        m_generation[row] = m_currentGeneration;
+    }
+
+    // Everything not in this scan has exited
+    for (int row = 0; row < m_pid.size(); ++row) {
+        if (m_pid.at(row) != 0 && m_generation.at(row) != m_currentGeneration) {
+            removed.append(row);
+        }
+    }
+}
+
+void ProcessColumnStore::release(const QVector<int> &rows)
+{
+    for (int row : rows) {
+        m_rowOfPid.remove(m_pid.at(row));
+        m_pid[row] = 0;
+        m_name[row].clear();
+        m_changed[row] = 0;
+        m_freeRows.append(row);
+    }
+}
+
+int ProcessColumnStore::allocateRow(int pid)
+{
+    int row;
+    if (!m_freeRows.isEmpty()) {
+        row = m_freeRows.takeLast();
+    }
+    else {
+        row = m_pid.size();
+        m_pid.append(0);
+        m_name.append(QString());
+        m_state.append('?');
+        m_cpu.append(0.0);
+        m_rss.append(0);
+        m_threads.append(0);
+        m_io.append(0.0);
+        m_generation.append(0);
+        m_changed.append(0);
+    }
+
+    m_pid[row] = pid;
+    m_rowOfPid.insert(pid, row);
+
+    return row;
+}
@@ -0,0 +1,73 @@
+#ifndef PROCESSCOLUMNSTORE_H
+#define PROCESSCOLUMNSTORE_H
+
+#include "processmonitor.h"
+#include <QHash>
+#include <QVector>
+
+// Column-oriented copy of the process list. A process keeps its row for its
+// whole lifetime, so views can index rows through their own permutation
+// (sort/filter) and only the changed cells move between ticks. Rows of
+// exited processes are recycled once the view let go of them.
+class ProcessColumnStore
+{
+public:
+    enum Column {
+        PidColumn,
+        NameColumn,
+        StateColumn,
+        CpuColumn,
+        MemoryColumn,
+        ThreadsColumn,
+        IoColumn,
+        ColumnCount
+    };
+
+    // Merge one scan. added/removed receive store rows; removed rows keep
+    // their values until release()
+    void apply(const QVector<ProcessInfo> &processes, QVector<int> &added, QVector<int> &removed);
+    void release(const QVector<int> &rows);
+
+    // Row capacity including free rows
+    int size() const {
+        return m_pid.size();
+    }
+
+    bool isLive(int row) const {
+        return m_pid.at(row) != 0;
+    }
+
+    // Bit (1 << Column) for every column the last apply() changed
+    quint32 changedColumns(int row) const {
+        return m_changed.at(row);
+    }
+
+    // Column access
+    int pid(int row) const { return m_pid.at(row); }
+    const QString &name(int row) const { return m_name.at(row); }
+    char state(int row) const { return m_state.at(row); }
+    double cpuUsage(int row) const { return m_cpu.at(row); }
+    qint64 rss(int row) const { return m_rss.at(row); }
+    int threads(int row) const { return m_threads.at(row); }
+    double ioRate(int row) const { return m_io.at(row); }
+
+private:
+    int allocateRow(int pid);
+
+    QVector<int> m_pid;             // 0 = free row
+    QVector<QString> m_name;
+    QVector<char> m_state;
+    QVector<double> m_cpu;
+    QVector<qint64> m_rss;
+    QVector<int> m_threads;
+    QVector<double> m_io;
+
+    QVector<quint32> m_generation;
+    QVector<quint32> m_changed;
+    quint32 m_currentGeneration = 0;
+
+    QHash<int, int> m_rowOfPid;
+    QVector<int> m_freeRows;
+};
+
+#endif // PROCESSCOLUMNSTORE_H
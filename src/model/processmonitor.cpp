@@ -0,0 +1,340 @@
+#include "processmonitor.h"
+#include "../core/constants.h"
+#include "../controller/datacontroller.h"
+#include "../core/procpidparser.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QRunnable>
+#include <QThread>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+    const int SCAN_CHUNK_SIZE = 512;    // Slots per pool task
+    const int MAX_SCAN_THREADS = 8;
+    const int PID_FILE_BUFFER = 2048;   // stat is ~350 bytes, statm ~40
+
+    // One-shot read of a small file relative to dirFd into buffer. error
+    // gets the errno of a failed open() or read().
+    ByteView readAt(int dirFd, const char *path, char *buffer, int capacity,
+                    int *error = nullptr)
+    {
+        ByteView view;
+
+        int fd = ::openat(dirFd, path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            if (error) {
+                *error = errno;
+            }
+            return view;    // Process exited since the directory walk
+        }
+
+        ssize_t n;
+        do {
+            n = ::read(fd, buffer, capacity);
+        } while (n < 0 && errno == EINTR);
+        if (n < 0 && error) {
+            *error = errno;     // /proc/pid/io checks access at read time too
+        }
+        ::close(fd);
+
+        if (n > 0) {
+            view.data = buffer;
+            view.size = int(n);
+        }
+        return view;
+    }
+}
+
+class ProcessMonitor::ScanTask : public QRunnable
+{
+public:
+    ScanTask(const ProcessMonitor *monitor, ProcessSlot *slots, const int *indices,
+             int count, double elapsedSec)
+        : m_monitor(monitor), m_slots(slots), m_indices(indices)
+        , m_count(count), m_elapsedSec(elapsedSec)
+    {
+    }
+
+    void run() override
+    {
+        m_monitor->scanRange(m_slots, m_indices, m_count, m_elapsedSec);
+    }
+
+private:
+    const ProcessMonitor *m_monitor;
+    ProcessSlot *m_slots;
+    const int *m_indices;
+    int m_count;
+    double m_elapsedSec;
+};
+
+ProcessMonitor::ProcessMonitor(QObject *parent)
+    : BaseMonitor(parent)
+{
+    setUpdateInterval(Constants::PROCESS_UPDATE_INTERVAL);
+
+    m_procDir = ::opendir(Constants::PROC_DIR.toLocal8Bit().constData());
+    if (!m_procDir) {
+        qDebug() << "Cannot open" << Constants::PROC_DIR << "- process monitoring disabled";
+    }
+
+    long ticks = ::sysconf(_SC_CLK_TCK);
+    if (ticks > 0) {
+        m_clockTicks = double(ticks);
+    }
+
+    long pageSize = ::sysconf(_SC_PAGESIZE);
+    if (pageSize > 0) {
+        m_pageSize = pageSize;
+    }
+
+    m_pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), MAX_SCAN_THREADS));
+
+    qDebug() << "ProcessMonitor initialized - scan threads:" << m_pool.maxThreadCount();
+}
+
+ProcessMonitor::~ProcessMonitor()
+{
+    // Drain the sampler before our members go away
+    stop();
+
+    if (m_procDir) {
+        ::closedir(m_procDir);
+    }
+}
+
+void ProcessMonitor::collectData()
+{
+    if (!m_procDir) {
+        throw std::runtime_error("Failed to open /proc");
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    m_sample.timestamp = SampleTime::now();
+    const double elapsedSec = m_previousTime.secondsTo(m_sample.timestamp);
+
+    listProcesses();
+    releaseExitedSlots();
+
+    // Slots are not added or removed until the tasks are done, so the raw
+    // pointers stay valid and every task owns a disjoint set of slots
+    ProcessSlot *slots = m_slots.data();
+    const int *indices = m_active.constData();
+    const int count = m_active.size();
+
+    if (count <= SCAN_CHUNK_SIZE) {
+        scanRange(slots, indices, count, elapsedSec);
+    }
+    else {
+        for (int begin = 0; begin < count; begin += SCAN_CHUNK_SIZE) {
+            int chunk = qMin(SCAN_CHUNK_SIZE, count - begin);
+            m_pool.start(new ScanTask(this, slots, indices + begin, chunk, elapsedSec));
+        }
+        m_pool.waitForDone();
+    }
+
+    m_previousTime = m_sample.timestamp;
+
+    buildSnapshot();
+    m_sample.scanTime = timer.nsecsElapsed() / 1e6;
+
+    // Hand an immutable copy to the GUI thread
+    const ProcessData snapshot = m_sample;
+    publish([this, snapshot]() {
+        m_processData = snapshot;
+        emit processDataUpdated(m_processData);
+    });
+
+    qDebug() << "Processes:" << m_sample.processCount()
+             << "Threads:" << m_sample.threadCount
+             << "Scan:" << m_sample.scanTime << "ms";
+}
+
+void ProcessMonitor::appendMetrics(MetricSample &sample) const
+{
+    sample.values.insert("process.count", m_sample.processCount());
+    sample.values.insert("process.threads", m_sample.threadCount);
+}
+
+bool ProcessMonitor::listProcesses()
+{
+    ++m_generation;
+    m_active.resize(0);     // Keeps the capacity
+
+    ::rewinddir(m_procDir);
+    while (dirent *entry = ::readdir(m_procDir)) {
+        // Numeric entries only - pids never start with 0
+        const char *name = entry->d_name;
+        if (*name < '1' || *name > '9') {
+            continue;
+        }
+
+        int pid = 0;
+        while (*name >= '0' && *name <= '9') {
+            pid = pid * 10 + (*name - '0');
+            ++name;
+        }
+        if (*name != '\0') {
+            continue;
+        }
+
+        int slot = acquireSlot(pid);
+        m_slots[slot].generation = m_generation;
+        m_active.append(slot);
+    }
+
+    return !m_active.isEmpty();
+}
+
+int ProcessMonitor::acquireSlot(int pid)
+{
+    int slot = m_slotIndex.value(pid, -1);
+    if (slot >= 0) {
+        return slot;
+    }
+
+    // New pid - the only place a process pays setup cost
+    if (!m_freeSlots.isEmpty()) {
+        slot = m_freeSlots.takeLast();
+    }
+    else {
+        slot = m_slots.size();
+        m_slots.append(ProcessSlot());
+    }
+
+    m_slots[slot].pid = pid;
+    m_slotIndex.insert(pid, slot);
+
+    return slot;
+}
+
+void ProcessMonitor::releaseExitedSlots()
+{
+    for (int i = 0; i < m_slots.size(); ++i) {
+        ProcessSlot &slot = m_slots[i];
+        if (slot.pid == 0 || slot.generation == m_generation) {
+            continue;
+        }
+
+        m_slotIndex.remove(slot.pid);
+        slot = ProcessSlot();
+        m_freeSlots.append(i);
+    }
+}
+
+void ProcessMonitor::scanRange(ProcessSlot *slots, const int *indices, int count,
+                               double elapsedSec) const
+{
+    const int dirFd = ::dirfd(m_procDir);
+    char path[32];
+    char buffer[PID_FILE_BUFFER];
+
+    for (int i = 0; i < count; ++i) {
+        ProcessSlot &slot = slots[indices[i]];
+        ProcessInfo &info = slot.info;
+
+        std::snprintf(path, sizeof(path), "%d/stat", slot.pid);
+        PidStat stat;
+        if (!ProcPidParser::parseStat(readAt(dirFd, path, buffer, sizeof(buffer)), stat)) {
+            slot.valid = false;
+            continue;
+        }
+
+        // Same pid, different process - start over
+        if (slot.hasPrevious && stat.startTime != info.startTime) {
+            slot.hasPrevious = false;
+            slot.ioDenied = false;
+            slot.comm[0] = '\0';
+        }
+        const bool hasPrevious = slot.hasPrevious && elapsedSec > 0;
+
+        // Only rebuild the name when comm changed (new pid or exec)
+        if (std::strcmp(slot.comm, stat.comm) != 0) {
+            std::memcpy(slot.comm, stat.comm, sizeof(slot.comm));
+            info.name = QString::fromLocal8Bit(stat.comm);
+        }
+
+        info.pid = slot.pid;
+        info.ppid = stat.ppid;
+        info.state = stat.state;
+        info.nice = stat.nice;
+        info.threads = stat.numThreads;
+        info.startTime = stat.startTime;
+        info.virtualMemory = qint64(stat.virtualSize);
+
+        const quint64 ticks = stat.utime + stat.stime;
+        if (hasPrevious && ticks >= slot.prevTicks) {
+            info.cpuUsage = (ticks - slot.prevTicks) / m_clockTicks / elapsedSec * 100.0;
+        }
+        else {
+            info.cpuUsage = 0.0;    // First sample of this process
+        }
+        slot.prevTicks = ticks;
+        slot.hasPrevious = true;
+
+        std::snprintf(path, sizeof(path), "%d/statm", slot.pid);
+        PidStatm statm;
+        if (ProcPidParser::parseStatm(readAt(dirFd, path, buffer, sizeof(buffer)), statm)) {
+            info.rss = qint64(statm.resident) * m_pageSize;
+            info.sharedMemory = qint64(statm.shared) * m_pageSize;
+        }
+        else {
+            info.rss = stat.rssPages * m_pageSize;
+            info.sharedMemory = 0;
+        }
+
+        // Other users' processes answer EACCES on open() or read() - remember
+        // it for this pid
+        PidIo io;
+        int ioError = 0;
+        if (!slot.ioDenied) {
+            std::snprintf(path, sizeof(path), "%d/io", slot.pid);
+            ByteView bytes = readAt(dirFd, path, buffer, sizeof(buffer), &ioError);
+            slot.ioDenied = ioError == EACCES || ioError == EPERM;
+            if (!ProcPidParser::parseIo(bytes, io)) {
+                io.readBytes = slot.prevReadBytes;
+                io.writeBytes = slot.prevWriteBytes;
+            }
+        }
+
+        if (hasPrevious && !slot.ioDenied) {
+            info.ioReadRate = (io.readBytes - qMin(io.readBytes, slot.prevReadBytes)) / elapsedSec;
+            info.ioWriteRate = (io.writeBytes - qMin(io.writeBytes, slot.prevWriteBytes)) / elapsedSec;
+        }
+        else {
+            info.ioReadRate = 0.0;
+            info.ioWriteRate = 0.0;
+        }
+        slot.prevReadBytes = io.readBytes;
+        slot.prevWriteBytes = io.writeBytes;
+
+        slot.valid = true;
+    }
+}
+
+void ProcessMonitor::buildSnapshot()
+{
+    // Fresh vector - the previous one is still shared with the GUI thread
+    QVector<ProcessInfo> processes;
+    processes.reserve(m_active.size());
+
+    int threads = 0;
+    for (int index : m_active) {
+        const ProcessSlot &slot = m_slots.at(index);
+        if (slot.valid) {
+            processes.append(slot.info);
+            threads += slot.info.threads;
+        }
+    }
+
+    m_sample.processes = processes;
+    m_sample.threadCount = threads;
+}
@@ -0,0 +1,119 @@
+#ifndef PROCESSMONITOR_H
+#define PROCESSMONITOR_H
+
+#include "base/basemonitor.h"
+#include "../core/sampletime.h"
+#include <QHash>
+#include <QThreadPool>
+#include <QVector>
+
+#include <dirent.h>
+
+struct ProcessInfo {
+    int pid = 0;
+    int ppid = 0;
+    QString name;                   // comm, not the full command line
+    char state = '?';
+    int nice = 0;
+    int threads = 0;
+    double cpuUsage = 0.0;          // Percent of one core (top style, may exceed 100)
+    qint64 rss = 0;                 // Resident memory in bytes
+    qint64 sharedMemory = 0;        // Resident shared pages in bytes
+    qint64 virtualMemory = 0;       // Bytes
+    double ioReadRate = 0.0;        // Storage bytes/s, 0 if /proc/[pid]/io is not readable
+    double ioWriteRate = 0.0;
+    quint64 startTime = 0;          // Clock ticks after boot
+
+    double ioRate() const {
+        return ioReadRate + ioWriteRate;
+    }
+};
+
+struct ProcessData {
+    // Every process seen in this scan, in /proc directory order
+    QVector<ProcessInfo> processes;
+    int threadCount = 0;
+    double scanTime = 0.0;          // Milliseconds spent in the last scan
+
+    // Taken when the scan started - CPU% divides by these intervals
+    SampleTime timestamp;
+
+    int processCount() const {
+        return processes.size();
+    }
+};
+
+class ProcessMonitor : public BaseMonitor
+{
+    Q_OBJECT
+public:
+    explicit ProcessMonitor(QObject *parent = nullptr);
+    ~ProcessMonitor() override;
+
+    // Data access
+    const ProcessData &data() const {
+        return m_processData;
+    }
+
+    const QVector<ProcessInfo> &processes() const {
+        return m_processData.processes;
+    }
+
+    int processCount() const {
+        return m_processData.processCount();
+    }
+
+signals:
+    void processDataUpdated(const ProcessData &data);
+
+protected:
+    void collectData() override;
+    void appendMetrics(MetricSample &sample) const override;
+
+private:
+    // Per-pid state kept between ticks; only new pids pay the setup cost
+    struct ProcessSlot {
+        int pid = 0;                // 0 = free slot
+        quint32 generation = 0;     // Last scan that listed this pid
+        bool valid = false;         // stat/statm read in the last scan
+        bool hasPrevious = false;   // prevTicks belongs to this process
+        quint64 prevTicks = 0;      // utime + stime of the previous scan
+        quint64 prevReadBytes = 0;
+        quint64 prevWriteBytes = 0;
+        bool ioDenied = false;      // Not our process - don't retry every tick
+        char comm[32] = {};         // Raw comm bytes behind info.name
+        ProcessInfo info;
+    };
+
+    class ScanTask;
+
+    // Directory walk and slot bookkeeping (sampler thread)
+    bool listProcesses();
+    int acquireSlot(int pid);
+    void releaseExitedSlots();
+
+    // Read stat/statm of the given slots - runs on pool threads, every
+    // slot is written by exactly one task
+    void scanRange(ProcessSlot *slots, const int *indices, int count,
+                   double elapsedSec) const;
+
+    void buildSnapshot();
+
+    ProcessData m_processData;      // Published data (GUI thread)
+
+    // Working state below is only touched on the sampler thread
+    ProcessData m_sample;
+    DIR *m_procDir = nullptr;       // openat() base for every pid file
+    QVector<ProcessSlot> m_slots;
+    QVector<int> m_freeSlots;
+    QHash<int, int> m_slotIndex;    // pid -> slot
+    QVector<int> m_active;          // Slots listed in the current scan
+    quint32 m_generation = 0;
+    SampleTime m_previousTime;
+
+    QThreadPool m_pool;             // Private so a long scan never starves others
+    double m_clockTicks = 100.0;    // sysconf(_SC_CLK_TCK)
+    qint64 m_pageSize = 4096;
+};
+
+#endif // PROCESSMONITOR_H
@@ -0,0 +1,344 @@
+#include "sensormonitor.h"
+#include "../core/constants.h"
+#include "../controller/datacontroller.h"
+#include "../core/systemUtils.h"
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QPair>
+#include <QRegularExpression>
+#include <algorithm>
+
+namespace {
+    // hwmon drivers whose temperatures are CPU die/package readings
+    const char *const CPU_HWMON_CHIPS[] = { "coretemp", "k10temp", "zenpower", "cpu_thermal" };
+
+    // Small text attribute read once at discovery ("name", "type", labels)
+    QString readAttribute(const QString &path)
+    {
+        if (!QFileInfo::exists(path)) {
+            return QString();
+        }
+        return SystemUtils::readFile(path).trimmed();
+    }
+
+    // "cpu12" -> 12, anything else -> -1
+    int cpuNumber(const QString &name)
+    {
+        if (!name.startsWith("cpu")) {
+            return -1;
+        }
+        bool ok;
+        int number = name.mid(3).toInt(&ok);
+        return ok ? number : -1;
+    }
+
+    bool isCpuZone(const QString &type)
+    {
+        // x86_pkg_temp on Intel, cpu-thermal/cpu0_thermal style on ARM SoCs
+        return type == "x86_pkg_temp" || type.contains("cpu", Qt::CaseInsensitive);
+    }
+
+    bool isCpuChip(const QString &chip)
+    {
+        for (const char *name : CPU_HWMON_CHIPS) {
+            if (chip == QLatin1String(name)) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+SensorMonitor::SensorMonitor(QObject *parent)
+    : BaseMonitor(parent)
+{
+    setUpdateInterval(Constants::SENSOR_UPDATE_INTERVAL);
+
+    // The sensor set is fixed at boot - enumerate once
+    discoverThermalZones();
+    discoverHwmon();
+    discoverThrottleCounters();
+    m_sensorData = m_sample;
+
+    qDebug() << "SensorMonitor initialized -" << m_sample.sensors.size() << "sensors,"
+             << m_sample.throttle.size() << "throttle counters";
+}
+
+SensorMonitor::~SensorMonitor()
+{
+    // Drain the sampler before our readers go away
+    stop();
+
+    qDeleteAll(m_sensorReaders);
+    qDeleteAll(m_coreThrottleReaders);
+    qDeleteAll(m_packageThrottleReaders);
+}
+
+void SensorMonitor::collectData()
+{
+    m_sample.timestamp = SampleTime::now();
+
+    readSensors();
+    readThrottleCounters();
+
+    // Hand an immutable copy to the GUI thread
+    const SensorData snapshot = m_sample;
+    publish([this, snapshot]() {
+        m_sensorData = snapshot;
+        emit sensorDataUpdated(m_sensorData);
+    });
+
+    qDebug() << "Sensors: CPU" << m_sample.cpuTemperature << "°C Max" << m_sample.maxTemperature
+             << "°C Throttle events:" << m_sample.newThrottleEvents;
+}
+
+void SensorMonitor::appendMetrics(MetricSample &sample) const
+{
+    sample.values.insert("sensor.cpu_temperature", m_sample.cpuTemperature);
+    sample.values.insert("sensor.max_temperature", m_sample.maxTemperature);
+    sample.values.insert("sensor.throttle_events", double(m_sample.newThrottleEvents));
+}
+
+void SensorMonitor::discoverThermalZones()
+{
+    QDir dir(Constants::SYS_THERMAL_DIR);
+    QStringList zones = dir.entryList(QStringList() << "thermal_zone*", QDir::Dirs);
+
+    // Numeric order - thermal_zone10 after thermal_zone9
+    std::sort(zones.begin(), zones.end(), [](const QString &a, const QString &b) {
+        return a.mid(12).toInt() < b.mid(12).toInt();
+    });
+
+    for (const QString &zone : zones) {
+        const QString base = dir.filePath(zone);
+        const QString type = readAttribute(base + "/type");
+        addSensor(base + "/temp", SensorReading::Temperature, 0.001, type, zone, isCpuZone(type));
+    }
+}
+
+void SensorMonitor::discoverHwmon()
+{
+    static const QRegularExpression inputPattern("^(temp|fan|in|power)(\\d+)_input$");
+
+    QDir dir(Constants::SYS_HWMON_DIR);
+    QStringList chips = dir.entryList(QStringList() << "hwmon*", QDir::Dirs);
+    std::sort(chips.begin(), chips.end(), [](const QString &a, const QString &b) {
+        return a.mid(5).toInt() < b.mid(5).toInt();
+    });
+
+    for (const QString &hwmon : chips) {
+        QDir chipDir(dir.filePath(hwmon));
+        const QString chip = readAttribute(chipDir.filePath("name"));
+        const bool cpuChip = isCpuChip(chip);
+
+        struct Input {
+            SensorReading::Kind kind;
+            int index;
+            QString prefix;
+        };
+        QVector<Input> inputs;
+
+        const QStringList files = chipDir.entryList(QStringList() << "*_input", QDir::Files);
+        for (const QString &file : files) {
+            QRegularExpressionMatch match = inputPattern.match(file);
+            if (!match.hasMatch()) {
+                continue;
+            }
+
+            const QString type = match.captured(1);
+            Input input;
+            input.kind = type == "temp" ? SensorReading::Temperature
+                       : type == "fan" ? SensorReading::Fan
+                       : type == "in" ? SensorReading::Voltage
+                       : SensorReading::Power;
+            input.index = match.captured(2).toInt();
+            input.prefix = type + match.captured(2);
+            inputs.append(input);
+        }
+
+        // Grouped by kind, numeric within a kind
+        std::sort(inputs.begin(), inputs.end(), [](const Input &a, const Input &b) {
+            return a.kind != b.kind ? a.kind < b.kind : a.index < b.index;
+        });
+
+        for (const Input &input : inputs) {
+            QString label = readAttribute(chipDir.filePath(input.prefix + "_label"));
+            if (label.isEmpty()) {
+                label = input.prefix;
+            }
+
+            // sysfs units: millidegrees, RPM, millivolts, microwatts
+            const double scale = input.kind == SensorReading::Temperature ? 0.001
+                               : input.kind == SensorReading::Fan ? 1.0
+                               : input.kind == SensorReading::Voltage ? 0.001
+                               : 0.000001;
+
+            addSensor(chipDir.filePath(input.prefix + "_input"), input.kind, scale, chip, label,
+                      cpuChip && input.kind == SensorReading::Temperature);
+        }
+    }
+}
+
+void SensorMonitor::discoverThrottleCounters()
+{
+    QDir dir(Constants::SYS_CPU_DIR);
+    QStringList cpus = dir.entryList(QStringList() << "cpu*", QDir::Dirs);
+    cpus.erase(std::remove_if(cpus.begin(), cpus.end(), [](const QString &name) {
+        return cpuNumber(name) < 0;
+    }), cpus.end());
+    std::sort(cpus.begin(), cpus.end(), [](const QString &a, const QString &b) {
+        return cpuNumber(a) < cpuNumber(b);
+    });
+
+    QVector<int> seenPackages;
+    QVector<QPair<int, int>> seenCores;     // (package, core_id)
+
+    for (const QString &cpu : cpus) {
+        const QString base = dir.filePath(cpu);
+        const QString corePath = base + "/thermal_throttle/core_throttle_count";
+        if (!QFileInfo::exists(corePath)) {
+            continue;   // Not Intel, or the cpu is offline
+        }
+
+        ThrottleCounters counters;
+        counters.cpu = cpuNumber(cpu);
+        counters.package = readAttribute(base + "/topology/physical_package_id").toInt();
+        counters.core = readAttribute(base + "/topology/core_id").toInt();
+
+        // SMT siblings report the same core counter
+        const QPair<int, int> core(counters.package, counters.core);
+        ProcFileReader *coreReader = nullptr;
+        if (!seenCores.contains(core)) {
+            seenCores.append(core);
+            coreReader = new ProcFileReader(corePath);
+        }
+
+        // Every core of a package reports the same package counter
+        ProcFileReader *packageReader = nullptr;
+        if (!seenPackages.contains(counters.package)) {
+            seenPackages.append(counters.package);
+            packageReader = new ProcFileReader(base + "/thermal_throttle/package_throttle_count");
+        }
+
+        m_sample.throttle.append(counters);
+        m_coreThrottleReaders.append(coreReader);
+        m_packageThrottleReaders.append(packageReader);
+    }
+}
+
+void SensorMonitor::addSensor(const QString &path, SensorReading::Kind kind, double scale,
+                              const QString &chip, const QString &label, bool cpu)
+{
+    SensorReading reading;
+    reading.kind = kind;
+    reading.chip = chip;
+    reading.label = label;
+    reading.cpu = cpu;
+
+    m_sample.sensors.append(reading);
+    m_sensorReaders.append(new ProcFileReader(path));
+    m_sensorScales.append(scale);
+}
+
+bool SensorMonitor::readValue(ProcFileReader *reader, qint64 &value)
+{
+    // Some hwmon inputs fail with EIO/ENODATA while the device sleeps
+    ByteView bytes = reader->read();
+    if (bytes.isEmpty()) {
+        return false;
+    }
+
+    bool ok;
+    value = SystemUtils::parseInt64(bytes, &ok);
+    return ok;
+}
+
+void SensorMonitor::readSensors()
+{
+    SensorReading *sensors = m_sample.sensors.data();
+    const int count = m_sample.sensors.size();
+
+    double cpuTemperature = 0.0;
+    double maxTemperature = 0.0;
+    bool haveCpu = false;
+    int firstZone = -1;
+
+    for (int i = 0; i < count; ++i) {
+        SensorReading &sensor = sensors[i];
+
+        qint64 raw;
+        sensor.valid = readValue(m_sensorReaders.at(i), raw);
+        if (!sensor.valid) {
+            continue;
+        }
+        sensor.value = raw * m_sensorScales.at(i);
+
+        if (sensor.kind != SensorReading::Temperature) {
+            continue;
+        }
+
+        maxTemperature = qMax(maxTemperature, sensor.value);
+        if (sensor.cpu) {
+            cpuTemperature = haveCpu ? qMax(cpuTemperature, sensor.value) : sensor.value;
+            haveCpu = true;
+        }
+        else if (firstZone < 0 && sensor.label.startsWith("thermal_zone")) {
+            firstZone = i;
+        }
+    }
+
+    // No recognisable CPU sensor - fall back to the first thermal zone
+    if (!haveCpu && firstZone >= 0) {
+        cpuTemperature = sensors[firstZone].value;
+    }
+
+    m_sample.cpuTemperature = cpuTemperature;
+    m_sample.maxTemperature = maxTemperature;
+}
+
+void SensorMonitor::readThrottleCounters()
+{
+    ThrottleCounters *throttle = m_sample.throttle.data();
+    const int count = m_sample.throttle.size();
+
+    quint64 coreTotal = 0;
+    quint64 packageTotal = 0;
+
+    for (int i = 0; i < count; ++i) {
+        qint64 value;
+
+        // Core counter read at its first SMT sibling, copied to the others
+        ProcFileReader *coreReader = m_coreThrottleReaders.at(i);
+        if (coreReader) {
+            if (readValue(coreReader, value)) {
+                for (int j = i; j < count; ++j) {
+                    if (throttle[j].package == throttle[i].package && throttle[j].core == throttle[i].core) {
+                        throttle[j].coreEvents = quint64(value);
+                    }
+                }
+            }
+            coreTotal += throttle[i].coreEvents;
+        }
+
+        // Package counter read at its first core, copied to the later ones
+        ProcFileReader *packageReader = m_packageThrottleReaders.at(i);
+        if (packageReader && readValue(packageReader, value)) {
+            packageTotal += quint64(value);
+            for (int j = i; j < count; ++j) {
+                if (throttle[j].package == throttle[i].package) {
+                    throttle[j].packageEvents = quint64(value);
+                }
+            }
+        }
+    }
+
+    const quint64 total = coreTotal + packageTotal;
+    m_sample.newThrottleEvents = m_haveThrottleSample && total >= m_previousThrottleEvents
+                               ? total - m_previousThrottleEvents : 0;
+    m_previousThrottleEvents = total;
+    m_haveThrottleSample = true;
+
+    m_sample.coreThrottleEvents = coreTotal;
+    m_sample.packageThrottleEvents = packageTotal;
+}
@@ -0,0 +1,111 @@
+#ifndef SENSORMONITOR_H
+#define SENSORMONITOR_H
+
+#include "base/basemonitor.h"
+#include "../core/procfilereader.h"
+#include "../core/sampletime.h"
+#include <QVector>
+
+// One thermal zone or hwmon input
+struct SensorReading {
+    enum Kind {
+        Temperature,
+        Fan,
+        Voltage,
+        Power
+    };
+
+    Kind kind = Temperature;
+    QString chip;                   // hwmon "name" or thermal zone "type"
+    QString label;                  // "Package id 0", "Core 3", "fan1", "thermal_zone2"
+    double value = 0.0;             // °C, RPM, V or W
+    bool cpu = false;               // Die or package sensor of a CPU
+    bool valid = false;             // Last read succeeded
+};
+
+// Thermal throttle events of one logical CPU since boot
+struct ThrottleCounters {
+    int cpu = 0;
+    int package = 0;
+    int core = 0;                   // core_id within the package
+    quint64 coreEvents = 0;         // Shared by the SMT siblings of the core
+    quint64 packageEvents = 0;      // Shared by every core of the package
+};
+
+struct SensorData {
+    QVector<SensorReading> sensors;
+    QVector<ThrottleCounters> throttle;
+
+    // Headline values
+    double cpuTemperature = 0.0;        // Hottest CPU sensor across all sockets
+    double maxTemperature = 0.0;        // Hottest sensor of any kind
+    quint64 coreThrottleEvents = 0;     // Since boot, each core once
+    quint64 packageThrottleEvents = 0;  // Since boot, each package once
+    quint64 newThrottleEvents = 0;      // Since the previous sample
+
+    // Taken when the sensors were read
+    SampleTime timestamp;
+};
+
+// Enumerates every thermal zone, hwmon temp/fan/in/power input and CPU
+// thermal_throttle counter once, keeps a descriptor open on each and
+// re-reads them all with pread() every tick.
+class SensorMonitor : public BaseMonitor
+{
+    Q_OBJECT
+public:
+    explicit SensorMonitor(QObject *parent = nullptr);
+    ~SensorMonitor() override;
+
+    // Data access
+    const SensorData &data() const {
+        return m_sensorData;
+    }
+
+    double cpuTemperature() const {
+        return m_sensorData.cpuTemperature;
+    }
+
+    const QVector<SensorReading> &sensors() const {
+        return m_sensorData.sensors;
+    }
+
+signals:
+    void sensorDataUpdated(const SensorData &data);
+
+protected:
+    void collectData() override;
+    void appendMetrics(MetricSample &sample) const override;
+
+private:
+    // Discovery - constructor only
+    void discoverThermalZones();
+    void discoverHwmon();
+    void discoverThrottleCounters();
+    void addSensor(const QString &path, SensorReading::Kind kind, double scale,
+                   const QString &chip, const QString &label, bool cpu);
+
+    // Every tick
+    void readSensors();
+    void readThrottleCounters();
+    static bool readValue(ProcFileReader *reader, qint64 &value);
+
+    SensorData m_sensorData;        // Published data (GUI thread)
+
+    // Working state below is only touched on the sampler thread
+    SensorData m_sample;
+
+    // One open descriptor per sensor, same order as m_sample.sensors
+    QVector<ProcFileReader *> m_sensorReaders;
+    QVector<double> m_sensorScales;     // Raw sysfs unit to °C, RPM, V or W
+
+    // Same order as m_sample.throttle; core readers only for the first SMT
+    // sibling of each core, package readers only for the first cpu of each
+    // package, nullptr for the rest
+    QVector<ProcFileReader *> m_coreThrottleReaders;
+    QVector<ProcFileReader *> m_packageThrottleReaders;
+    quint64 m_previousThrottleEvents = 0;
+    bool m_haveThrottleSample = false;
+};
+
+#endif // SENSORMONITOR_H
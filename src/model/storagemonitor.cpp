@@ -0,0 +1,409 @@
+#include "storagemonitor.h"
+#include "../core/constants.h"
+#include "../controller/datacontroller.h"
+#include "../core/netdevparser.h"
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QSet>
+#include <cerrno>
+#include <cstring>
+
+#include <poll.h>
+
+namespace {
+    const double SECTOR_SIZE = 512.0;   // diskstats sectors, independent of the device
+
+    // Fallback for when sysfs is not mounted. A disk whose name ends in a
+    // digit takes a 'p' before the partition number ("nvme0n1p2", "mmcblk0p1",
+    // "md1p1"), others take the number directly ("sda1") - so "dm-10" is not a
+    // partition of "dm-1", nor "nvme0n11" of "nvme0n1".
+    bool isPartitionOf(const char *name, const char *disk)
+    {
+        const size_t diskLength = std::strlen(disk);
+        if (diskLength == 0 || std::strncmp(name, disk, diskLength) != 0) {
+            return false;
+        }
+
+        const char *suffix = name + diskLength;
+        const char last = disk[diskLength - 1];
+        if (last >= '0' && last <= '9') {
+            if (*suffix != 'p') {
+                return false;
+            }
+            ++suffix;
+        }
+        if (*suffix == '\0') {
+            return false;
+        }
+        for (; *suffix; ++suffix) {
+            if (*suffix < '0' || *suffix > '9') {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+StorageMonitor::StorageMonitor(QObject *parent)
+    : BaseMonitor(parent)
+    , m_prober(Constants::STORAGE_PROBE_THREADS,
+               Constants::STORAGE_PROBE_MAX_THREADS,
+               Constants::STORAGE_PROBE_DEADLINE,
+               Constants::STORAGE_PROBE_MAX_BACKOFF)
+    , m_mountsReader(Constants::PROC_MOUNTS)
+    , m_diskStatsReader(Constants::PROC_DISKSTATS)
+{
+    setUpdateInterval(Constants::STORAGE_UPDATE_INTERVAL);
+
+    // Usage of a new mount shows up as soon as its first probe answers,
+    // not one interval later. Posted to our thread: a worker must not
+    // collect (probe() takes the lock the callback runs under).
+    m_prober.setFirstResultCallback([this]() {
+        QMetaObject::invokeMethod(this, [this]() {
+            if (isRunning()) {
+                updateNow();
+            }
+        }, Qt::QueuedConnection);
+    });
+
+    qDebug() << "StorageMonitor initialized";
+}
+
+StorageMonitor::~StorageMonitor()
+{
+    // No more wake-ups from workers, then drain the sampler before our
+    // members go away
+    m_prober.setFirstResultCallback(nullptr);
+    stop();
+}
+
+void StorageMonitor::collectData()
+{
+    readMountTable();
+    updateMountUsage();
+
+    if (readDiskStats()) {
+        syncDiskTable();
+        calculateRates();
+    }
+
+    // Added mounts go out with their first usage values
+    QVector<MountUsage> added;
+    for (int index : m_addedMounts) {
+        added.append(m_sample.mounts.at(index));
+    }
+    const QVector<MountUsage> removed = m_removedMounts;
+    m_addedMounts.clear();
+    m_removedMounts.clear();
+
+    // Hand an immutable copy to the GUI thread
+    const StorageData snapshot = m_sample;
+    publish([this, snapshot, added, removed]() {
+        m_storageData = snapshot;
+        for (const MountUsage &mount : removed) {
+            emit mountRemoved(mount);
+        }
+        for (const MountUsage &mount : added) {
+            emit mountAdded(mount);
+        }
+        emit storageDataUpdated(m_storageData);
+    });
+
+    qDebug() << "Storage Usage:" << m_sample.usagePercentage
+             << "% Read:" << m_sample.readBytesRate / Constants::BYTES_PER_MB
+             << "MB/s Write:" << m_sample.writeBytesRate / Constants::BYTES_PER_MB
+             << "MB/s Busiest:" << m_sample.busiestDisk << m_sample.maxUtilization << "%";
+}
+
+void StorageMonitor::appendMetrics(MetricSample &sample) const
+{
+    sample.values.insert("storage.usage", m_sample.usagePercentage);
+    sample.values.insert("storage.read", m_sample.readBytesRate);
+    sample.values.insert("storage.write", m_sample.writeBytesRate);
+    sample.values.insert("storage.utilization", m_sample.maxUtilization);
+}
+
+bool StorageMonitor::readMountTable()
+{
+    // Steady state: one non-blocking poll(), no read or parse
+    if (!m_mountsDirty && !mountTableChanged()) {
+        return true;
+    }
+
+    ByteView bytes = m_mountsReader.read();
+    if (bytes.isEmpty()) {
+        // Fallback for non-Linux systems - root filesystem only
+        if (m_mountPaths.isEmpty()) {
+            MountUsage root;
+            root.mountPoint = "/";
+            m_sample.mounts = QVector<MountUsage>() << root;
+            m_mountPaths = QVector<QByteArray>() << QByteArray("/");
+            m_rootIndex = 0;
+        }
+        return false;
+    }
+
+    m_mountsDirty = false;
+    rebuildMounts(bytes);
+
+    return true;
+}
+
+bool StorageMonitor::mountTableChanged()
+{
+    // The kernel raises POLLPRI|POLLERR on an open mounts file once the
+    // namespace's mount table changed, and clears it on that poll
+    pollfd pfd;
+    pfd.fd = m_mountsReader.fd();
+    pfd.events = POLLPRI;
+    pfd.revents = 0;
+    if (pfd.fd < 0) {
+        return true;
+    }
+
+    int ready;
+    do {
+        ready = ::poll(&pfd, 1, 0);
+    } while (ready < 0 && errno == EINTR);
+
+    // On error just re-read - correct, only slower
+    return ready != 0;
+}
+
+void StorageMonitor::rebuildMounts(const ByteView &bytes)
+{
+    MountParser::parse(bytes, m_mountEntries);
+
+    // Previous table by path, for the add/remove diff
+    QHash<QByteArray, int> previousIndex;
+    for (int i = 0; i < m_mountPaths.size(); ++i) {
+        previousIndex.insert(m_mountPaths.at(i), i);
+    }
+
+    QVector<MountUsage> mounts;
+    QVector<QByteArray> paths;
+    QSet<QByteArray> devices;
+    QVector<bool> kept(m_mountPaths.size(), false);
+    m_rootIndex = -1;
+
+    for (const MountEntry &entry : m_mountEntries) {
+        if (!MountParser::isRealFilesystem(entry)) {
+            continue;
+        }
+
+        // Bind mounts repeat the device - count each filesystem once
+        QByteArray device(entry.device.data, entry.device.size);
+        if (devices.contains(device)) {
+            continue;
+        }
+        devices.insert(device);
+
+        MountUsage usage;
+        usage.device = MountParser::decodePath(entry.device);
+        usage.mountPoint = MountParser::decodePath(entry.mountPoint);
+        usage.fsType = QString::fromLatin1(entry.fsType.data, entry.fsType.size);
+
+        const QByteArray path = usage.mountPoint.toLocal8Bit();
+        const int old = previousIndex.value(path, -1);
+        if (old >= 0 && m_sample.mounts.at(old).device == usage.device) {
+            usage = m_sample.mounts.at(old);    // Keep the last usage values
+            kept[old] = true;
+        }
+        else if (m_mountsLoaded) {
+            m_addedMounts.append(mounts.size());
+        }
+
+        if (usage.mountPoint == "/") {
+            m_rootIndex = mounts.size();
+        }
+
+        paths.append(path);
+        mounts.append(usage);
+    }
+
+    if (m_mountsLoaded) {
+        for (int i = 0; i < kept.size(); ++i) {
+            if (!kept.at(i)) {
+                m_removedMounts.append(m_sample.mounts.at(i));
+            }
+        }
+    }
+
+    qDebug() << "Storage mount table changed -" << mounts.size() << "filesystems"
+             << "(+" << m_addedMounts.size() << "-" << m_removedMounts.size() << ")";
+
+    m_sample.mounts = mounts;
+    m_mountPaths = paths;
+    m_mountsLoaded = true;
+}
+
+void StorageMonitor::updateMountUsage()
+{
+    QVector<MountUsage> &mounts = m_sample.mounts;
+
+    // Never blocks, even on a dead NFS server - takes what has answered
+    m_prober.probe(m_mountPaths, m_probes);
+
+    for (int i = 0; i < mounts.size(); ++i) {
+        MountUsage &usage = mounts[i];
+        const MountProbe &probe = m_probes.at(i);
+
+        usage.valid = probe.ok;
+        usage.stale = probe.stale;
+        if (!probe.ok) {
+            continue;
+        }
+
+        usage.totalBytes = probe.totalBytes;
+        usage.usedBytes = probe.usedBytes;
+        usage.availableBytes = probe.availableBytes;
+
+        // df style: reserved blocks count neither as used nor available
+        const qint64 usable = usage.usedBytes + usage.availableBytes;
+        usage.usagePercentage = usable > 0 ? (double)usage.usedBytes / usable * 100.0 : 0.0;
+    }
+
+    // Headline: root filesystem, else the first one that answered
+    const MountUsage *primary = nullptr;
+    if (m_rootIndex >= 0 && mounts.at(m_rootIndex).valid) {
+        primary = &mounts.at(m_rootIndex);
+    }
+    for (int i = 0; !primary && i < mounts.size(); ++i) {
+        if (mounts.at(i).valid) {
+            primary = &mounts.at(i);
+        }
+    }
+
+    m_sample.usagePercentage = primary ? primary->usagePercentage : 0.0;
+    m_sample.totalBytes = primary ? primary->totalBytes : 0;
+    m_sample.usedBytes = primary ? primary->usedBytes : 0;
+}
+
+bool StorageMonitor::readDiskStats()
+{
+    ByteView bytes = m_diskStatsReader.read();
+    m_sample.timestamp = SampleTime::now();
+    if (bytes.isEmpty()) {
+        return false;
+    }
+
+    DiskStatsParser::parse(bytes, m_diskCounters);
+    return true;
+}
+
+void StorageMonitor::syncDiskTable()
+{
+    QVector<DiskIoStats> &table = m_sample.disks;
+    const int count = m_diskCounters.size();
+
+    bool sameLayout = table.size() == count;
+    for (int i = 0; sameLayout && i < count; ++i) {
+        sameLayout = std::strcmp(table[i].counters.name, m_diskCounters[i].name) == 0;
+    }
+
+    if (sameLayout) {
+        return;     // Steady state - nothing to rebuild
+    }
+
+    // Carry previous counters over by name; new devices start from their
+    // current values so their first rate is 0
+    QHash<QByteArray, int> previousIndex;
+    for (int i = 0; i < table.size(); ++i) {
+        previousIndex.insert(QByteArray(table[i].counters.name), i);
+    }
+
+    QVector<DiskCounters> previous(count);
+    QVector<DiskIoStats> rebuilt(count);
+    for (int i = 0; i < count; ++i) {
+        int old = previousIndex.value(QByteArray(m_diskCounters[i].name), -1);
+        previous[i] = old >= 0 ? m_previousDiskCounters.value(old, m_diskCounters[i]) : m_diskCounters[i];
+        rebuilt[i].name = QString::fromLatin1(m_diskCounters[i].name);
+        rebuilt[i].counters = m_diskCounters[i];
+
+        // Partitions and stacked devices are skipped in the totals so I/O
+        // isn't counted twice. sysfs knows both: partitions have a
+        // "partition" attribute, dm/md/bcache devices list their members
+        // under "slaves".
+        const QString sysPath = Constants::SYS_BLOCK_DIR + "/" + rebuilt[i].name;
+        if (QFileInfo::exists(sysPath)) {
+            rebuilt[i].partition = QFileInfo::exists(sysPath + "/partition");
+            rebuilt[i].stacked = !QDir(sysPath + "/slaves").isEmpty(QDir::AllEntries | QDir::NoDotAndDotDot);
+            continue;
+        }
+
+        for (int j = 0; j < count && !rebuilt[i].partition; ++j) {
+            rebuilt[i].partition = j != i && isPartitionOf(m_diskCounters[i].name, m_diskCounters[j].name);
+        }
+    }
+
+    m_previousDiskCounters = previous;
+    table = rebuilt;
+
+    qDebug() << "Block device set changed -" << count << "devices";
+}
+
+void StorageMonitor::calculateRates()
+{
+    QVector<DiskIoStats> &table = m_sample.disks;
+    const int count = qMin(table.size(), m_diskCounters.size());
+
+    const double timeDiffSec = m_previousTime.secondsTo(m_sample.timestamp);
+
+    DiskIoStats *stats = table.data();
+    const DiskCounters *current = m_diskCounters.constData();
+    DiskCounters *previous = m_previousDiskCounters.data();
+
+    double readRate = 0.0;
+    double writeRate = 0.0;
+    double maxUtilization = 0.0;
+    int busiest = -1;
+
+    for (int i = 0; i < count; ++i) {
+        DiskIoStats &entry = stats[i];
+        const DiskCounters &cur = current[i];
+        const DiskCounters &prev = previous[i];
+
+        if (timeDiffSec > 0) {
+            // Same wrap rules as the network counters (unsigned long in the kernel)
+            const quint64 reads = NetDevParser::counterDelta(cur.readsCompleted, prev.readsCompleted);
+            const quint64 writes = NetDevParser::counterDelta(cur.writesCompleted, prev.writesCompleted);
+            const quint64 readTime = NetDevParser::counterDelta(cur.readTimeMs, prev.readTimeMs);
+            const quint64 writeTime = NetDevParser::counterDelta(cur.writeTimeMs, prev.writeTimeMs);
+            const quint64 ioTime = NetDevParser::counterDelta(cur.ioTimeMs, prev.ioTimeMs);
+
+            entry.readBytesRate = NetDevParser::counterDelta(cur.sectorsRead, prev.sectorsRead) * SECTOR_SIZE / timeDiffSec;
+            entry.writeBytesRate = NetDevParser::counterDelta(cur.sectorsWritten, prev.sectorsWritten) * SECTOR_SIZE / timeDiffSec;
+            entry.readIops = reads / timeDiffSec;
+            entry.writeIops = writes / timeDiffSec;
+            entry.awaitMs = (reads + writes) > 0 ? double(readTime + writeTime) / (reads + writes) : 0.0;
+            entry.utilization = qMin(100.0, ioTime / (timeDiffSec * 1000.0) * 100.0);
+        }
+
+        entry.counters = cur;
+        previous[i] = cur;
+
+        if (!entry.partition) {
+            // A stacked device's I/O is already in its members' counters,
+            // but its own utilisation still counts - a saturated dm or md
+            // device is a saturated disk as far as its users are concerned
+            if (!entry.stacked) {
+                readRate += entry.readBytesRate;
+                writeRate += entry.writeBytesRate;
+            }
+            if (entry.utilization > maxUtilization || busiest < 0) {
+                maxUtilization = entry.utilization;
+                busiest = i;
+            }
+        }
+    }
+
+    m_sample.readBytesRate = readRate;
+    m_sample.writeBytesRate = writeRate;
+    m_sample.maxUtilization = maxUtilization;
+    m_sample.busiestDisk = busiest >= 0 ? stats[busiest].name : QString();
+
+    // Store current time for next calculation
+    m_previousTime = m_sample.timestamp;
+}
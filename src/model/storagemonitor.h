@@ -0,0 +1,125 @@
+#ifndef STORAGEMONITOR_H
+#define STORAGEMONITOR_H
+
+#include "base/basemonitor.h"
+#include "../core/procfilereader.h"
+#include "../core/mountparser.h"
+#include "../core/diskstatsparser.h"
+#include "../core/mountprober.h"
+#include "../core/sampletime.h"
+#include <QVector>
+
+// Capacity of one mounted filesystem (statvfs, df style)
+struct MountUsage {
+    QString device;
+    QString mountPoint;
+    QString fsType;
+    qint64 totalBytes = 0;
+    qint64 usedBytes = 0;
+    qint64 availableBytes = 0;      // Available to unprivileged users
+    double usagePercentage = 0.0;   // used / (used + available)
+    bool valid = false;             // statvfs succeeded
+    bool stale = false;             // Probe hung - values are from an older one
+};
+
+// Throughput of one block device (rates per second)
+struct DiskIoStats {
+    QString name;
+    bool partition = false;         // Also counted in its parent disk
+    bool stacked = false;           // dm/md device - I/O also counted in its members
+    DiskCounters counters;
+    double readBytesRate = 0.0;
+    double writeBytesRate = 0.0;
+    double readIops = 0.0;
+    double writeIops = 0.0;
+    double awaitMs = 0.0;           // Average time per completed request
+    double utilization = 0.0;       // Percent of the interval with I/O queued
+};
+
+struct StorageData {
+    QVector<MountUsage> mounts;
+    QVector<DiskIoStats> disks;
+
+    // Headline values: root filesystem, whole disks only
+    double usagePercentage = 0.0;
+    qint64 totalBytes = 0;
+    qint64 usedBytes = 0;
+    double readBytesRate = 0.0;
+    double writeBytesRate = 0.0;
+    double maxUtilization = 0.0;
+    QString busiestDisk;
+
+    // Taken at the /proc/diskstats read
+    SampleTime timestamp;
+};
+
+class StorageMonitor : public BaseMonitor
+{
+    Q_OBJECT
+public:
+    explicit StorageMonitor(QObject *parent = nullptr);
+    ~StorageMonitor() override;
+
+    // Data access
+    const StorageData &data() const {
+        return m_storageData;
+    }
+
+    double usage() const {
+        return m_storageData.usagePercentage;
+    }
+
+    const QVector<MountUsage> &mounts() const {
+        return m_storageData.mounts;
+    }
+
+    const QVector<DiskIoStats> &disks() const {
+        return m_storageData.disks;
+    }
+
+signals:
+    void storageDataUpdated(const StorageData &data);
+
+    // Mount table changes, emitted before the storageDataUpdated they belong to
+    void mountAdded(const MountUsage &mount);
+    void mountRemoved(const MountUsage &mount);
+
+protected:
+    void collectData() override;
+    void appendMetrics(MetricSample &sample) const override;
+
+private:
+    // Mount table - rebuilt only when poll() reports a change
+    bool readMountTable();
+    bool mountTableChanged();
+    void rebuildMounts(const ByteView &bytes);
+    void updateMountUsage();
+
+    // Block device throughput
+    bool readDiskStats();
+    void syncDiskTable();
+    void calculateRates();
+
+    StorageData m_storageData;      // Published data (GUI thread)
+
+    // Working state below is only touched on the sampler thread
+    StorageData m_sample;
+    QVector<QByteArray> m_mountPaths;   // Encoded paths for statvfs, same order as mounts
+    int m_rootIndex = -1;
+    bool m_mountsDirty = true;          // Re-read the table on the next tick
+    bool m_mountsLoaded = false;        // First table read - no add/remove events
+    QVector<MountEntry> m_mountEntries;
+    QVector<int> m_addedMounts;         // Indices into mounts, until published
+    QVector<MountUsage> m_removedMounts;
+    MountProber m_prober;
+    QVector<MountProbe> m_probes;       // Same order as mounts
+
+    QVector<DiskCounters> m_diskCounters;
+    QVector<DiskCounters> m_previousDiskCounters;
+    SampleTime m_previousTime;
+
+    ProcFileReader m_mountsReader;
+    ProcFileReader m_diskStatsReader;
+};
+
+#endif // STORAGEMONITOR_H
@@ -0,0 +1,112 @@
+#include "topktracker.h"
+#include <algorithm>
+
+TopKTracker::TopKTracker(RankKey key, int capacity)
+    : m_key(key)
+    , m_capacity(qMax(1, capacity))
+{
+    m_heap.reserve(m_capacity);
+}
+
+double TopKTracker::keyValue(const ProcessInfo &process, RankKey key)
+{
+    switch (key) {
+    case ByCpu:
+        return process.cpuUsage;
+    case ByMemory:
+        return double(process.rss);
+    case ByIo:
+        return process.ioRate();
+    }
+    return 0.0;
+}
+
+bool TopKTracker::ranksAbove(const ProcessInfo &a, const ProcessInfo &b) const
+{
+    double valueA = keyValue(a, m_key);
+    double valueB = keyValue(b, m_key);
+    if (valueA != valueB) {
+        return valueA > valueB;
+    }
+    return a.pid < b.pid;
+}
+
+const QVector<TopKTracker::RankChange> &TopKTracker::update(const QVector<ProcessInfo> &processes)
+{
+    // Min-heap of the best k so far: the root is the weakest entry and the
+    // only one a new candidate has to beat
+    auto weaker = [this](const ProcessInfo *a, const ProcessInfo *b) {
+        return ranksAbove(*a, *b);
+    };
+
+    m_heap.resize(0);
+    for (const ProcessInfo &process : processes) {
+        if (m_heap.size() < m_capacity) {
+            m_heap.append(&process);
+            std::push_heap(m_heap.begin(), m_heap.end(), weaker);
+        }
+        else if (ranksAbove(process, *m_heap.first())) {
+            std::pop_heap(m_heap.begin(), m_heap.end(), weaker);
+            m_heap.last() = &process;
+            std::push_heap(m_heap.begin(), m_heap.end(), weaker);
+        }
+    }
+
+    // Only the k survivors get sorted
+    std::sort_heap(m_heap.begin(), m_heap.end(), weaker);
+
+    QVector<int> previousPids = m_pids;
+
+    m_entries.resize(m_heap.size());
+    m_pids.resize(m_heap.size());
+    for (int i = 0; i < m_heap.size(); ++i) {
+        m_entries[i] = *m_heap.at(i);
+        m_pids[i] = m_heap.at(i)->pid;
+    }
+
+    buildChanges(previousPids);
+    return m_changes;
+}
+
+void TopKTracker::buildChanges(const QVector<int> &previousPids)
+{
+    m_changes.resize(0);
+    QVector<int> rows = previousPids;
+
+    // Bottom-up removal of entries that dropped out keeps earlier row
+    // numbers valid
+    for (int row = rows.size() - 1; row >= 0; --row) {
+        if (!m_pids.contains(rows.at(row))) {
+            RankChange change;
+            change.type = RankChange::Remove;
+            change.from = row;
+            m_changes.append(change);
+            rows.remove(row);
+        }
+    }
+
+    // Walk the new ranking top-down; rows above 'row' are already final,
+    // so each mismatch is one move up or one insert (k is small, linear
+    // searches are fine)
+    for (int row = 0; row < m_pids.size(); ++row) {
+        const int pid = m_pids.at(row);
+        if (row < rows.size() && rows.at(row) == pid) {
+            continue;
+        }
+
+        RankChange change;
+        change.to = row;
+
+        int from = rows.indexOf(pid, row);
+        if (from >= 0) {
+            change.type = RankChange::Move;
+            change.from = from;
+            rows.move(from, row);
+        }
+        else {
+            change.type = RankChange::Insert;
+            rows.insert(row, pid);
+        }
+        m_changes.append(change);
+    }
+}
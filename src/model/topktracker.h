@@ -0,0 +1,70 @@
+#ifndef TOPKTRACKER_H
+#define TOPKTRACKER_H
+
+#include "processmonitor.h"
+#include <QVector>
+
+// Keeps the k largest processes by one key without sorting the whole list.
+// Every update costs O(n log k) through a bounded min-heap, and produces the
+// row edit script (removes, moves, inserts) turning the previous ranking
+// into the new one so views never need a full reset.
+class TopKTracker
+{
+public:
+    enum RankKey {
+        ByCpu,          // cpuUsage
+        ByMemory,       // rss
+        ByIo            // ioReadRate + ioWriteRate
+    };
+
+    // One row edit, applied in order. Rows are positions in the ranking
+    // as it stands after the previous edits.
+    struct RankChange {
+        enum Type {
+            Remove,     // Drop row 'from'
+            Move,       // Move row 'from' up to row 'to'
+            Insert      // New entry at row 'to'
+        };
+
+        Type type = Remove;
+        int from = -1;
+        int to = -1;
+    };
+
+    explicit TopKTracker(RankKey key = ByCpu, int capacity = 10);
+
+    RankKey key() const {
+        return m_key;
+    }
+
+    int capacity() const {
+        return m_capacity;
+    }
+
+    // Rank one scan; returns the edits from the previous ranking
+    const QVector<RankChange> &update(const QVector<ProcessInfo> &processes);
+
+    // Current ranking, largest first
+    const QVector<ProcessInfo> &entries() const {
+        return m_entries;
+    }
+
+    static double keyValue(const ProcessInfo &process, RankKey key);
+
+private:
+    // Strict ordering: larger key first, lower pid breaks ties so equal
+    // values don't shuffle rows between ticks
+    bool ranksAbove(const ProcessInfo &a, const ProcessInfo &b) const;
+
+    void buildChanges(const QVector<int> &previousPids);
+
+    RankKey m_key;
+    int m_capacity;
+
+    QVector<const ProcessInfo *> m_heap;    // Reused every update
+    QVector<ProcessInfo> m_entries;
+    QVector<int> m_pids;                    // Working ranking for the diff
+    QVector<RankChange> m_changes;
+};
+
+#endif // TOPKTRACKER_H
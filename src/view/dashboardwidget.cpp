@@ -3,6 +3,10 @@
 #include "../model/cpumonitor.h"
 #include "../model/memorymonitor.h"
 #include "../model/networkmonitor.h"
+#include "../model/storagemonitor.h"
+#include "../model/sensormonitor.h"
+#include "../model/pressuremonitor.h"
+#include "../controller/datacontroller.h"
 #include "../core/constants.h"
 #include "../core/systemUtils.h"
 #include <QDateTime>
@@ -13,16 +17,13 @@ DashboardWidget::DashboardWidget(QWidget *parent)
     , m_mainLayout(new QVBoxLayout(this))
     , m_metricsLayout(new QGridLayout)
     , m_systemInfoLayout(new QHBoxLayout)
-    , m_timeUpdateTimer(new QTimer(this))
 {
     setupUI();
     setupMetricCards();
     setupSystemInfoSection();
     applyDashboardStyling();
 
-    // Setup time update
-    connect(m_timeUpdateTimer, &QTimer::timeout, this, &DashboardWidget::updateCurrentTime);
-    m_timeUpdateTimer->start(1000);
+    // Time updates arrive with scheduler ticks (see connectDataController)
     updateCurrentTime();
 
     qDebug() << "DashboardWidget initialized";
@@ -82,6 +83,7 @@ void DashboardWidget::setupSystemInfoSection()
     m_timeLabel = new QLabel(this);
     m_hostnameLabel = new QLabel(this);
     m_uptimeLabel = new QLabel(this);
+    m_pressureLabel = new QLabel(this);
 
     // Style labels
     QFont dateTimeFont;
@@ -94,12 +96,14 @@ void DashboardWidget::setupSystemInfoSection()
     infoFont.setPointSize(10);
     m_hostnameLabel->setFont(infoFont);
     m_uptimeLabel->setFont(infoFont);
+    m_pressureLabel->setFont(infoFont);
 
     // Set colors
     m_dateLabel->setStyleSheet("color: #ECF0F1;");
     m_timeLabel->setStyleSheet("color: #3498DB;");
     m_hostnameLabel->setStyleSheet("color: #95A5A6;");
     m_uptimeLabel->setStyleSheet("color: #95A5A6;");
+    m_pressureLabel->setStyleSheet("color: #95A5A6;");
 
     // Layout system info
     m_systemInfoLayout->addWidget(m_dateLabel);
@@ -109,6 +113,8 @@ void DashboardWidget::setupSystemInfoSection()
     m_systemInfoLayout->addWidget(m_hostnameLabel);
     m_systemInfoLayout->addStretch();
     m_systemInfoLayout->addWidget(m_uptimeLabel);
+    m_systemInfoLayout->addStretch();
+    m_systemInfoLayout->addWidget(m_pressureLabel);
 
     // Initialize with current data
     updateSystemInfo(SystemUtils::getHostname(), SystemUtils::getUptime());
@@ -134,13 +140,10 @@ void DashboardWidget::connectCPUMonitor(CPUMonitor *monitor)
     if (monitor) {
         connect(monitor, &CPUMonitor::cpuDataUpdated,
                 this, [this](const CPUData &data) {
-                    updateCPUMetrics(data.usage, data.temperature);
+                    updateCPUMetrics(data.usage, m_cpuTemperature);
 
-                    QString subtitle = QString("Temp: %1°C").arg(data.temperature, 0, 'f', 1);
-                    if (!data.model.isEmpty() && data.model != "Unknown CPU") {
-                        subtitle += QString(" | %1").arg(data.model.left(20)); // Truncate long names
-                    }
-                    m_cpuCard->setSubtitle(subtitle);
+                    m_cpuModel = data.model;
+                    updateCPUSubtitle();
                 });
 
         qDebug() << "CPU Monitor connected to dashboard";
@@ -190,6 +193,158 @@ void DashboardWidget::connectNetworkMonitor(NetworkMonitor *monitor)
     }
 }
 
+void DashboardWidget::connectStorageMonitor(StorageMonitor *monitor)
+{
+    if (m_storageMonitor) {
+        disconnect(m_storageMonitor, nullptr, this, nullptr);
+    }
+
+    m_storageMonitor = monitor;
+
+    if (monitor) {
+        connect(monitor, &StorageMonitor::storageDataUpdated, this, [this](const StorageData &data) {
+            updateStorageMetrics(data.usagePercentage);
+
+            QString subtitle = QString("%1 / %2 | R %3 W %4 MB/s")
+                                   .arg(MemoryMonitor::formatBytes(data.usedBytes))
+                                   .arg(MemoryMonitor::formatBytes(data.totalBytes))
+                                   .arg(data.readBytesRate / Constants::BYTES_PER_MB, 0, 'f', 1)
+                                   .arg(data.writeBytesRate / Constants::BYTES_PER_MB, 0, 'f', 1);
+            m_storageCard->setSubtitle(subtitle);
+        });
+
+        qDebug() << "Storage Monitor connected to dashboard";
+    }
+}
+
+void DashboardWidget::connectSensorMonitor(SensorMonitor *monitor)
+{
+    if (m_sensorMonitor) {
+        disconnect(m_sensorMonitor, nullptr, this, nullptr);
+    }
+
+    m_sensorMonitor = monitor;
+
+    if (monitor) {
+        connect(monitor, &SensorMonitor::sensorDataUpdated, this, [this](const SensorData &data) {
+            m_cpuTemperature = data.cpuTemperature;
+            updateCPUSubtitle();
+        });
+
+        qDebug() << "Sensor Monitor connected to dashboard";
+    }
+}
+
+void DashboardWidget::connectPressureMonitor(PressureMonitor *monitor)
+{
+    if (m_pressureMonitor) {
+        disconnect(m_pressureMonitor, nullptr, this, nullptr);
+    }
+
+    m_pressureMonitor = monitor;
+
+    if (monitor) {
+        connect(monitor, &PressureMonitor::pressureDataUpdated, this, [this](const PressureData &data) {
+            Q_UNUSED(data)
+            updatePressure();
+        });
+
+        // Stalls caught by a trigger show up before the next average
+        connect(monitor, &PressureMonitor::pressureStall, this,
+                [this](PressureData::Resource resource, const PressureData &data) {
+            Q_UNUSED(data)
+            m_lastStall = QString("%1 stall at %2")
+                              .arg(PressureData::resourceName(resource))
+                              .arg(QDateTime::currentDateTime().toString("hh:mm:ss"));
+            updatePressure();
+        });
+
+        connect(monitor, &PressureMonitor::levelChanged, this,
+                [this](PressureData::Resource resource, PressureData::Level level) {
+            qDebug() << "Dashboard pressure level:" << PressureData::resourceName(resource) << level;
+            if (m_pressureMonitor->data().worstLevel() == PressureData::Normal) {
+                m_lastStall.clear();
+            }
+            updatePressure();
+        });
+
+        qDebug() << "Pressure Monitor connected to dashboard";
+    }
+}
+
+void DashboardWidget::connectDataController(DataController *controller)
+{
+    if (m_dataController) {
+        disconnect(m_dataController, nullptr, this, nullptr);
+    }
+
+    m_dataController = controller;
+
+    if (controller) {
+        connect(controller, &DataController::sampleReady, this, [this](const MetricSample &sample) {
+            Q_UNUSED(sample)
+            updateCurrentTime();
+            updateWindowAggregates();
+        });
+
+        qDebug() << "DataController connected to dashboard";
+    }
+}
+
+void DashboardWidget::updateCPUSubtitle()
+{
+    // Temperature and model come from different monitors
+    QString subtitle = QString("Temp: %1°C").arg(m_cpuTemperature, 0, 'f', 1);
+    if (!m_cpuModel.isEmpty() && m_cpuModel != "Unknown CPU") {
+        subtitle += QString(" | %1").arg(m_cpuModel.left(20)); // Truncate long names
+    }
+    m_cpuCard->setSubtitle(subtitle);
+}
+
+void DashboardWidget::updateWindowAggregates()
+{
+    // Running windows in the store - nothing is rescanned per tick
+    const MetricStore &store = m_dataController->metricStore();
+    const qint64 window = Constants::METRIC_WINDOW_MEDIUM;
+    WindowStats stats;
+
+    if (store.windowStats("cpu.usage", window, stats)) {
+        m_cpuCard->setSecondary(QString("avg 1m: %1%").arg(stats.mean, 0, 'f', 0));
+    }
+    if (store.windowStats("memory.usage", window, stats)) {
+        m_memoryCard->setSecondary(QString("avg 1m: %1%").arg(stats.mean, 0, 'f', 0));
+    }
+    if (store.windowStats("network.download", window, stats)) {
+        m_networkCard->setSecondary(QString("avg 1m: %1 MB/s down").arg(stats.mean, 0, 'f', 1));
+    }
+    if (store.windowStats("storage.utilization", window, stats)) {
+        m_storageCard->setSecondary(QString("peak 1m: %1% busy").arg(stats.max, 0, 'f', 0));
+    }
+}
+
+void DashboardWidget::updatePressure()
+{
+    const PressureData &data = m_pressureMonitor->data();
+
+    QString text = QString("PSI cpu %1% mem %2% io %3%")
+                       .arg(data.system.cpu.some.avg10, 0, 'f', 1)
+                       .arg(data.system.memory.some.avg10, 0, 'f', 1)
+                       .arg(data.system.io.some.avg10, 0, 'f', 1);
+    if (!m_lastStall.isEmpty()) {
+        text += " | " + m_lastStall;
+    }
+    m_pressureLabel->setText(text);
+
+    // Same colours as the card thresholds
+    QString color = "#95A5A6";
+    if (data.worstLevel() == PressureData::Critical) {
+        color = Constants::CRITICAL_COLOR;
+    } else if (data.worstLevel() == PressureData::Warning || !m_lastStall.isEmpty()) {
+        color = Constants::WARNING_COLOR;
+    }
+    m_pressureLabel->setStyleSheet(QString("color: %1;").arg(color));
+}
+
 void DashboardWidget::updateCPUMetrics(double usage, double temperature)
 {
     if (m_cpuCard) {
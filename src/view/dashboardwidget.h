@@ -6,12 +6,15 @@
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
-#include <QTimer>
 
 class MetricCard;
 class CPUMonitor;
 class MemoryMonitor;
 class NetworkMonitor;
+class StorageMonitor;
+class SensorMonitor;
+class PressureMonitor;
+class DataController;
 
 class DashboardWidget : public QWidget
 {
@@ -23,6 +26,12 @@ public:
     void connectCPUMonitor(CPUMonitor *monitor);
     void connectMemoryMonitor(MemoryMonitor *monitor);
     void connectNetworkMonitor(NetworkMonitor *monitor);
+    void connectStorageMonitor(StorageMonitor *monitor);
+    void connectSensorMonitor(SensorMonitor *monitor);
+    void connectPressureMonitor(PressureMonitor *monitor);
+
+    // Scheduler tick drives the clock - no separate timer wake-ups
+    void connectDataController(DataController *controller);
 
     // Manual update methods (for testing and fake data)
     void updateCPUMetrics(double usage, double temperature = 0.0);
@@ -39,6 +48,9 @@ private:
     void setupMetricCards();
     void setupSystemInfoSection();
     void applyDashboardStyling();
+    void updateCPUSubtitle();
+    void updateWindowAggregates();
+    void updatePressure();
 
     //  Main layout
     QVBoxLayout *m_mainLayout;
@@ -56,14 +68,23 @@ private:
     QLabel *m_timeLabel;
     QLabel *m_hostnameLabel;
     QLabel *m_uptimeLabel;
+    QLabel *m_pressureLabel;
+
+    // CPU card subtitle parts (model from CPUMonitor, temperature from SensorMonitor)
+    QString m_cpuModel;
+    double m_cpuTemperature = 0.0;
 
-    // Update timer
-    QTimer *m_timeUpdateTimer;
+    // Last PSI trigger, shown until pressure is back to normal
+    QString m_lastStall;
 
     // Connected monitors (weak references)
     CPUMonitor *m_cpuMonitor = nullptr;
     MemoryMonitor *m_memoryMonitor = nullptr;
     NetworkMonitor *m_networkMonitor = nullptr;
+    StorageMonitor *m_storageMonitor = nullptr;
+    SensorMonitor *m_sensorMonitor = nullptr;
+    PressureMonitor *m_pressureMonitor = nullptr;
+    DataController *m_dataController = nullptr;
 };
 
 #endif // DASHBOARDWIDGET_H
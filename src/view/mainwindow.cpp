@@ -1,5 +1,7 @@
 #include "mainwindow.h"
 #include "src/view/dashboardwidget.h"
+#include "src/view/topprocesseswidget.h"
+#include "src/view/processtablewidget.h"
 #include "src/core/constants.h"
 #include <QApplication>
 #include <QMenuBar>
@@ -11,6 +13,8 @@ MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , m_tabWidget(new QTabWidget(this))
     , m_dashboardWidget(new DashboardWidget(this))
+    , m_topProcessesWidget(new TopProcessesWidget(this))
+    , m_processTableWidget(new ProcessTableWidget(this))
     , m_statusLabel(new QLabel("Ready", this))
     , m_connectionLabel(new QLabel("Disconnected", this))
 {
@@ -94,6 +98,12 @@ void MainWindow::setupTabs()
     // Dashboard tab
     m_tabWidget->addTab(m_dashboardWidget, "Dashbooard");
 
+    // Top processes tab
+    m_tabWidget->addTab(m_topProcessesWidget, "Top Processes");
+
+    // Full process table
+    m_tabWidget->addTab(m_processTableWidget, "Processes");
+
     // Alerts tab (placeholder)
     m_alertsWidget = new QWidget(this);
     QVBoxLayout *alertsLayout = new QVBoxLayout(m_alertsWidget);
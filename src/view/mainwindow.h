@@ -9,6 +9,8 @@
 #include <QAction>
 
 class DashboardWidget;
+class TopProcessesWidget;
+class ProcessTableWidget;
 
 class MainWindow : public QMainWindow
 {
@@ -22,6 +24,14 @@ public:
         return m_dashboardWidget;
     }
 
+    TopProcessesWidget *topProcessesWidget() const {
+        return m_topProcessesWidget;
+    }
+
+    ProcessTableWidget *processTableWidget() const {
+        return m_processTableWidget;
+    }
+
 private slots:
     void showAbout();
     void onTabChanged(int index);
@@ -38,6 +48,8 @@ private:
 
     // Tabs
     DashboardWidget *m_dashboardWidget;
+    TopProcessesWidget *m_topProcessesWidget;
+    ProcessTableWidget *m_processTableWidget;
     QWidget *m_alertsWidget;
     QWidget *m_settingsWidget;
 
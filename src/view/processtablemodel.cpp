@@ -0,0 +1,343 @@
+#include "processtablemodel.h"
+#include "../model/memorymonitor.h"
+#include <algorithm>
+
+namespace {
+    // Changed rows closer than this are reported as one dataChanged range;
+    // the view only repaints what is visible anyway
+    const int CHANGE_RANGE_GAP = 32;
+
+    // m_viewRow marker for rows added by the current scan
+    const int NEW_ROW = -2;
+}
+
+ProcessTableModel::ProcessTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+int ProcessTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_order.size();
+}
+
+int ProcessTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ProcessColumnStore::ColumnCount;
+}
+
+QVariant ProcessTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_order.size()) {
+        return QVariant();
+    }
+
+    // O(1): one permutation lookup, one column read
+    const int row = m_order.at(index.row());
+
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+        case ProcessColumnStore::PidColumn:
+            return m_store.pid(row);
+        case ProcessColumnStore::NameColumn:
+            return m_store.name(row);
+        case ProcessColumnStore::StateColumn:
+            return QString(QChar::fromLatin1(m_store.state(row)));
+        case ProcessColumnStore::CpuColumn:
+            return QString::number(m_store.cpuUsage(row), 'f', 1);
+        case ProcessColumnStore::MemoryColumn:
+            return MemoryMonitor::formatBytes(m_store.rss(row));
+        case ProcessColumnStore::ThreadsColumn:
+            return m_store.threads(row);
+        case ProcessColumnStore::IoColumn:
+            return MemoryMonitor::formatBytes(qint64(m_store.ioRate(row))) + "/s";
+        default:
+            break;
+        }
+    }
+    else if (role == Qt::TextAlignmentRole) {
+        if (index.column() == ProcessColumnStore::NameColumn) {
+            return int(Qt::AlignLeft | Qt::AlignVCenter);
+        }
+        return int(Qt::AlignRight | Qt::AlignVCenter);
+    }
+
+    return QVariant();
+}
+
+QVariant ProcessTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    switch (section) {
+    case ProcessColumnStore::PidColumn:
+        return "PID";
+    case ProcessColumnStore::NameColumn:
+        return "Name";
+    case ProcessColumnStore::StateColumn:
+        return "State";
+    case ProcessColumnStore::CpuColumn:
+        return "CPU %";
+    case ProcessColumnStore::MemoryColumn:
+        return "Memory";
+    case ProcessColumnStore::ThreadsColumn:
+        return "Threads";
+    case ProcessColumnStore::IoColumn:
+        return "I/O";
+    default:
+        break;
+    }
+
+    return QVariant();
+}
+
+void ProcessTableModel::sort(int column, Qt::SortOrder order)
+{
+    m_sortColumn = column;
+    m_sortOrder = order;
+    resort();
+}
+
+void ProcessTableModel::setProcesses(const QVector<ProcessInfo> &processes)
+{
+    m_store.apply(processes, m_added, m_removed);
+
+    // New store rows are not placed yet
+    m_viewRow.resize(m_store.size());
+    for (int row : m_added) {
+        m_viewRow[row] = NEW_ROW;
+    }
+
+    QVector<int> hide = m_removed;
+    QVector<int> show;
+
+    // An exec can change the name and with it the filter verdict
+    if (!m_filterText.isEmpty()) {
+        const quint32 nameBit = 1u << ProcessColumnStore::NameColumn;
+        for (int row = 0; row < m_store.size(); ++row) {
+            if (!(m_store.changedColumns(row) & nameBit) || m_viewRow.at(row) == NEW_ROW) {
+                continue;
+            }
+            bool visible = m_viewRow.at(row) >= 0;
+            if (visible != acceptsRow(row)) {
+                (visible ? hide : show).append(row);
+            }
+        }
+    }
+
+    for (int row : m_added) {
+        if (acceptsRow(row)) {
+            show.append(row);
+        }
+    }
+
+    hideStoreRows(hide);
+    m_store.release(m_removed);
+    showStoreRows(show);
+    resort();
+    emitChangedRanges();
+}
+
+void ProcessTableModel::setFilterText(const QString &text)
+{
+    if (text == m_filterText) {
+        return;
+    }
+    m_filterText = text;
+
+    QVector<int> hide;
+    QVector<int> show;
+    for (int row = 0; row < m_store.size(); ++row) {
+        if (!m_store.isLive(row)) {
+            continue;
+        }
+        bool visible = m_viewRow.value(row, -1) >= 0;
+        if (visible != acceptsRow(row)) {
+            (visible ? hide : show).append(row);
+        }
+    }
+
+    hideStoreRows(hide);
+    showStoreRows(show);
+    resort();
+}
+
+bool ProcessTableModel::acceptsRow(int storeRow) const
+{
+    return m_filterText.isEmpty()
+           || m_store.name(storeRow).contains(m_filterText, Qt::CaseInsensitive);
+}
+
+bool ProcessTableModel::lessThan(int left, int right) const
+{
+    int result = 0;
+
+    switch (m_sortColumn) {
+    case ProcessColumnStore::NameColumn:
+        result = m_store.name(left).compare(m_store.name(right), Qt::CaseInsensitive);
+        break;
+    case ProcessColumnStore::StateColumn:
+        result = m_store.state(left) - m_store.state(right);
+        break;
+    case ProcessColumnStore::CpuColumn:
+        result = (m_store.cpuUsage(left) > m_store.cpuUsage(right)) - (m_store.cpuUsage(left) < m_store.cpuUsage(right));
+        break;
+    case ProcessColumnStore::MemoryColumn:
+        result = (m_store.rss(left) > m_store.rss(right)) - (m_store.rss(left) < m_store.rss(right));
+        break;
+    case ProcessColumnStore::ThreadsColumn:
+        result = m_store.threads(left) - m_store.threads(right);
+        break;
+    case ProcessColumnStore::IoColumn:
+        result = (m_store.ioRate(left) > m_store.ioRate(right)) - (m_store.ioRate(left) < m_store.ioRate(right));
+        break;
+    default:
+        break;
+    }
+
+    if (m_sortOrder == Qt::DescendingOrder) {
+        result = -result;
+    }
+
+    // Pid breaks ties so equal values keep a stable order between ticks
+    if (result == 0) {
+        return m_store.pid(left) < m_store.pid(right);
+    }
+    return result < 0;
+}
+
+void ProcessTableModel::hideStoreRows(const QVector<int> &storeRows)
+{
+    QVector<int> viewRows;
+    viewRows.reserve(storeRows.size());
+    for (int row : storeRows) {
+        int viewRow = m_viewRow.value(row, -1);
+        if (viewRow >= 0) {
+            viewRows.append(viewRow);
+        }
+    }
+
+    if (viewRows.isEmpty()) {
+        return;
+    }
+
+    // Bottom-up contiguous runs: removing a run never shifts the ones above
+    std::sort(viewRows.begin(), viewRows.end());
+    int last = viewRows.size() - 1;
+    while (last >= 0) {
+        int first = last;
+        while (first > 0 && viewRows.at(first - 1) == viewRows.at(first) - 1) {
+            --first;
+        }
+
+        const int firstRow = viewRows.at(first);
+        const int lastRow = viewRows.at(last);
+        beginRemoveRows(QModelIndex(), firstRow, lastRow);
+        m_order.remove(firstRow, lastRow - firstRow + 1);
+        endRemoveRows();
+
+        last = first - 1;
+    }
+
+    rebuildViewIndex();
+}
+
+void ProcessTableModel::showStoreRows(const QVector<int> &storeRows)
+{
+    if (storeRows.isEmpty()) {
+        return;
+    }
+
+    // One insert range at the end; resort() moves them into place
+    const int first = m_order.size();
+    beginInsertRows(QModelIndex(), first, first + storeRows.size() - 1);
+    m_order += storeRows;
+    endInsertRows();
+
+    rebuildViewIndex();
+}
+
+void ProcessTableModel::resort()
+{
+    if (m_sortColumn < 0) {
+        return;
+    }
+
+    auto compare = [this](int left, int right) {
+        return lessThan(left, right);
+    };
+
+    // Most ticks with a static key (PID, name) need no layout change
+    if (std::is_sorted(m_order.constBegin(), m_order.constEnd(), compare)) {
+        return;
+    }
+
+    emit layoutAboutToBeChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+
+    // Remember which store row every persistent index points at
+    const QModelIndexList persistent = persistentIndexList();
+    QVector<int> persistentRows;
+    persistentRows.reserve(persistent.size());
+    for (const QModelIndex &index : persistent) {
+        persistentRows.append(m_order.at(index.row()));
+    }
+
+    std::sort(m_order.begin(), m_order.end(), compare);
+    rebuildViewIndex();
+
+    QModelIndexList moved;
+    moved.reserve(persistent.size());
+    for (int i = 0; i < persistent.size(); ++i) {
+        moved.append(index(m_viewRow.at(persistentRows.at(i)), persistent.at(i).column()));
+    }
+    changePersistentIndexList(persistent, moved);
+
+    emit layoutChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+}
+
+void ProcessTableModel::rebuildViewIndex()
+{
+    m_viewRow.fill(-1, m_store.size());
+    for (int i = 0; i < m_order.size(); ++i) {
+        m_viewRow[m_order.at(i)] = i;
+    }
+}
+
+void ProcessTableModel::emitChangedRanges()
+{
+    const int count = m_order.size();
+    int row = 0;
+
+    while (row < count) {
+        quint32 columns = m_store.changedColumns(m_order.at(row));
+        if (!columns) {
+            ++row;
+            continue;
+        }
+
+        // Grow the range while the next changed row is close enough
+        int first = row;
+        int last = row;
+        for (int next = row + 1; next < count && next - last <= CHANGE_RANGE_GAP; ++next) {
+            quint32 changed = m_store.changedColumns(m_order.at(next));
+            if (changed) {
+                columns |= changed;
+                last = next;
+            }
+        }
+
+        int firstColumn = 0;
+        while (!(columns & (1u << firstColumn))) {
+            ++firstColumn;
+        }
+        int lastColumn = ProcessColumnStore::ColumnCount - 1;
+        while (!(columns & (1u << lastColumn))) {
+            --lastColumn;
+        }
+
+        emit dataChanged(index(first, firstColumn), index(last, lastColumn), {Qt::DisplayRole});
+        row = last + 1;
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef PROCESSTABLEMODEL_H
+#define PROCESSTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include "../model/processcolumnstore.h"
+
+// Full process table over a ProcessColumnStore. Sorting and filtering only
+// rearrange a permutation of store rows; nothing is copied. Every tick is
+// applied as grouped remove/insert ranges, a layout change when the sort
+// order moved and batched dataChanged ranges - never a model reset.
+class ProcessTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    explicit ProcessTableModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    // Feed one process scan
+    void setProcesses(const QVector<ProcessInfo> &processes);
+
+    // Case-insensitive substring match on the process name
+    void setFilterText(const QString &text);
+
+private:
+    bool acceptsRow(int storeRow) const;
+    bool lessThan(int left, int right) const;
+
+    // Structure changes in view terms
+    void hideStoreRows(const QVector<int> &storeRows);
+    void showStoreRows(const QVector<int> &storeRows);
+    void resort();
+    void rebuildViewIndex();
+    void emitChangedRanges();
+
+    ProcessColumnStore m_store;
+    QVector<int> m_order;       // View row -> store row
+    QVector<int> m_viewRow;     // Store row -> view row, -1 if hidden
+
+    int m_sortColumn = -1;
+    Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
+    QString m_filterText;
+
+    // Scratch lists reused every tick
+    QVector<int> m_added;
+    QVector<int> m_removed;
+};
+
+#endif // PROCESSTABLEMODEL_H
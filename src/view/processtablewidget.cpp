@@ -0,0 +1,103 @@
+#include "processtablewidget.h"
+#include "processtablemodel.h"
+#include "../model/processmonitor.h"
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLineEdit>
+#include <QTableView>
+#include <QDebug>
+
+ProcessTableWidget::ProcessTableWidget(QWidget *parent)
+    : QWidget(parent)
+    , m_mainLayout(new QVBoxLayout(this))
+    , m_filterEdit(new QLineEdit(this))
+    , m_countLabel(new QLabel(this))
+    , m_tableView(new QTableView(this))
+    , m_model(new ProcessTableModel(this))
+{
+    setupUI();
+    applyStyling();
+
+    qDebug() << "ProcessTableWidget initialized";
+}
+
+void ProcessTableWidget::setupUI()
+{
+    m_mainLayout->setContentsMargins(16, 16, 16, 16);
+    m_mainLayout->setSpacing(8);
+
+    // Filter bar
+    QHBoxLayout *filterLayout = new QHBoxLayout;
+    m_filterEdit->setPlaceholderText("Filter by name...");
+    m_filterEdit->setClearButtonEnabled(true);
+    m_countLabel->setStyleSheet("color: #95A5A6;");
+    filterLayout->addWidget(m_filterEdit, 1);
+    filterLayout->addWidget(m_countLabel);
+    m_mainLayout->addLayout(filterLayout);
+
+    connect(m_filterEdit, &QLineEdit::textChanged, m_model, &ProcessTableModel::setFilterText);
+
+    // Table - fixed row heights and interactive columns keep the view from
+    // measuring every row, so only the visible rows cost anything
+    m_tableView->setModel(m_model);
+    m_tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_tableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_tableView->setWordWrap(false);
+    m_tableView->setShowGrid(false);
+    m_tableView->verticalHeader()->setVisible(false);
+    m_tableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    m_tableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    m_tableView->horizontalHeader()->setSectionResizeMode(ProcessColumnStore::NameColumn, QHeaderView::Stretch);
+    m_tableView->setSortingEnabled(true);
+    m_tableView->sortByColumn(ProcessColumnStore::CpuColumn, Qt::DescendingOrder);
+    m_mainLayout->addWidget(m_tableView, 1);
+}
+
+void ProcessTableWidget::applyStyling()
+{
+    setStyleSheet(
+        "ProcessTableWidget {"
+        "    background-color: #2C3E50;"
+        "}"
+        "QLineEdit {"
+        "    background-color: #34495E;"
+        "    color: #ECF0F1;"
+        "    border: 1px solid #2C3E50;"
+        "    padding: 4px;"
+        "}"
+        "QTableView {"
+        "    background-color: #34495E;"
+        "    alternate-background-color: #3B5268;"
+        "    color: #ECF0F1;"
+        "    border: 1px solid #2C3E50;"
+        "    selection-background-color: #3498DB;"
+        "}"
+        "QHeaderView::section {"
+        "    background-color: #2C3E50;"
+        "    color: #95A5A6;"
+        "    border: none;"
+        "    padding: 4px;"
+        "}"
+        );
+    m_tableView->setAlternatingRowColors(true);
+}
+
+void ProcessTableWidget::connectProcessMonitor(ProcessMonitor *monitor)
+{
+    if (m_processMonitor) {
+        disconnect(m_processMonitor, nullptr, this, nullptr);
+    }
+
+    m_processMonitor = monitor;
+
+    if (monitor) {
+        connect(monitor, &ProcessMonitor::processDataUpdated, this, [this](const ProcessData &data) {
+            m_model->setProcesses(data.processes);
+            m_countLabel->setText(QString("%1 / %2 processes")
+                                      .arg(m_model->rowCount())
+                                      .arg(data.processCount()));
+        });
+
+        qDebug() << "Process Monitor connected to process table";
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef PROCESSTABLEWIDGET_H
+#define PROCESSTABLEWIDGET_H
+
+#include <QWidget>
+#include <QVBoxLayout>
+#include <QLabel>
+
+class QLineEdit;
+class QTableView;
+class ProcessTableModel;
+class ProcessMonitor;
+
+// Every process in one sortable, filterable table
+class ProcessTableWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit ProcessTableWidget(QWidget *parent = nullptr);
+
+    // Monitor integration
+    void connectProcessMonitor(ProcessMonitor *monitor);
+
+private:
+    void setupUI();
+    void applyStyling();
+
+    QVBoxLayout *m_mainLayout;
+    QLineEdit *m_filterEdit;
+    QLabel *m_countLabel;
+    QTableView *m_tableView;
+    ProcessTableModel *m_model;
+
+    // Connected monitor (weak reference)
+    ProcessMonitor *m_processMonitor = nullptr;
+};
+
+#endif // PROCESSTABLEWIDGET_H
@@ -0,0 +1,112 @@
+#include "topprocesseswidget.h"
+#include "topprocessmodel.h"
+#include "../model/processmonitor.h"
+#include <QHeaderView>
+#include <QTableView>
+#include <QDebug>
+
+namespace {
+    const int TOP_PROCESS_COUNT = 5;    // Rows per ranking
+}
+
+TopProcessesWidget::TopProcessesWidget(QWidget *parent)
+    : QWidget(parent)
+    , m_mainLayout(new QVBoxLayout(this))
+    , m_summaryLabel(new QLabel("Waiting for first scan...", this))
+    , m_cpuModel(new TopProcessModel(TopKTracker::ByCpu, TOP_PROCESS_COUNT, this))
+    , m_memoryModel(new TopProcessModel(TopKTracker::ByMemory, TOP_PROCESS_COUNT, this))
+    , m_ioModel(new TopProcessModel(TopKTracker::ByIo, TOP_PROCESS_COUNT, this))
+{
+    setupUI();
+    applyStyling();
+
+    qDebug() << "TopProcessesWidget initialized";
+}
+
+void TopProcessesWidget::setupUI()
+{
+    m_mainLayout->setContentsMargins(16, 16, 16, 16);
+    m_mainLayout->setSpacing(8);
+
+    m_summaryLabel->setStyleSheet("color: #95A5A6;");
+    m_mainLayout->addWidget(m_summaryLabel);
+
+    createTable("Top CPU", m_cpuModel);
+    createTable("Top Memory", m_memoryModel);
+    createTable("Top I/O", m_ioModel);
+
+    m_mainLayout->addStretch();
+}
+
+QTableView *TopProcessesWidget::createTable(const QString &title, TopProcessModel *model)
+{
+    QLabel *titleLabel = new QLabel(title, this);
+    QFont titleFont = titleLabel->font();
+    titleFont.setWeight(QFont::Bold);
+    titleLabel->setFont(titleFont);
+    titleLabel->setStyleSheet("color: #ECF0F1;");
+
+    QTableView *table = new QTableView(this);
+    table->setModel(model);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->verticalHeader()->setVisible(false);
+    table->horizontalHeader()->setSectionResizeMode(TopProcessModel::NameColumn, QHeaderView::Stretch);
+
+    // Fixed height for the k rows - no scrolling, no layout jumps
+    int rowHeight = table->verticalHeader()->defaultSectionSize();
+    table->setFixedHeight(table->horizontalHeader()->sizeHint().height()
+                          + rowHeight * TOP_PROCESS_COUNT + 2);
+    table->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+
+    m_mainLayout->addWidget(titleLabel);
+    m_mainLayout->addWidget(table);
+
+    return table;
+}
+
+void TopProcessesWidget::applyStyling()
+{
+    setStyleSheet(
+        "TopProcessesWidget {"
+        "    background-color: #2C3E50;"
+        "}"
+        "QTableView {"
+        "    background-color: #34495E;"
+        "    color: #ECF0F1;"
+        "    gridline-color: #2C3E50;"
+        "    border: 1px solid #2C3E50;"
+        "    selection-background-color: #3498DB;"
+        "}"
+        "QHeaderView::section {"
+        "    background-color: #2C3E50;"
+        "    color: #95A5A6;"
+        "    border: none;"
+        "    padding: 4px;"
+        "}"
+        );
+}
+
+void TopProcessesWidget::connectProcessMonitor(ProcessMonitor *monitor)
+{
+    if (m_processMonitor) {
+        disconnect(m_processMonitor, nullptr, this, nullptr);
+    }
+
+    m_processMonitor = monitor;
+
+    if (monitor) {
+        connect(monitor, &ProcessMonitor::processDataUpdated, this, [this](const ProcessData &data) {
+            m_cpuModel->setProcesses(data.processes);
+            m_memoryModel->setProcesses(data.processes);
+            m_ioModel->setProcesses(data.processes);
+
+            m_summaryLabel->setText(QString("%1 processes, %2 threads | scan %3 ms")
+                                        .arg(data.processCount())
+                                        .arg(data.threadCount)
+                                        .arg(data.scanTime, 0, 'f', 1));
+        });
+
+        qDebug() << "Process Monitor connected to top processes view";
+    }
+}
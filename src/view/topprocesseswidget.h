@@ -0,0 +1,39 @@
+#ifndef TOPPROCESSESWIDGET_H
+#define TOPPROCESSESWIDGET_H
+
+#include <QWidget>
+#include <QVBoxLayout>
+#include <QLabel>
+
+class QTableView;
+class TopProcessModel;
+class ProcessMonitor;
+
+// Top consumers by CPU, memory and I/O, one small table each
+class TopProcessesWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit TopProcessesWidget(QWidget *parent = nullptr);
+
+    // Monitor integration
+    void connectProcessMonitor(ProcessMonitor *monitor);
+
+private:
+    void setupUI();
+    QTableView *createTable(const QString &title, TopProcessModel *model);
+    void applyStyling();
+
+    QVBoxLayout *m_mainLayout;
+    QLabel *m_summaryLabel;
+
+    // One ranking per key
+    TopProcessModel *m_cpuModel;
+    TopProcessModel *m_memoryModel;
+    TopProcessModel *m_ioModel;
+
+    // Connected monitor (weak reference)
+    ProcessMonitor *m_processMonitor = nullptr;
+};
+
+#endif // TOPPROCESSESWIDGET_H
@@ -0,0 +1,121 @@
+#include "topprocessmodel.h"
+#include "../model/memorymonitor.h"
+
+TopProcessModel::TopProcessModel(TopKTracker::RankKey key, int capacity, QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_tracker(key, capacity)
+{
+}
+
+int TopProcessModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+int TopProcessModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant TopProcessModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rows.size()) {
+        return QVariant();
+    }
+
+    const ProcessInfo &process = m_rows.at(index.row());
+
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+        case PidColumn:
+            return process.pid;
+        case NameColumn:
+            return process.name;
+        case ValueColumn:
+            return formatValue(process);
+        default:
+            break;
+        }
+    }
+    else if (role == Qt::TextAlignmentRole && index.column() != NameColumn) {
+        return int(Qt::AlignRight | Qt::AlignVCenter);
+    }
+
+    return QVariant();
+}
+
+QVariant TopProcessModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    switch (section) {
+    case PidColumn:
+        return "PID";
+    case NameColumn:
+        return "Name";
+    case ValueColumn:
+        switch (m_tracker.key()) {
+        case TopKTracker::ByCpu:
+            return "CPU";
+        case TopKTracker::ByMemory:
+            return "Memory";
+        case TopKTracker::ByIo:
+            return "I/O";
+        }
+        break;
+    default:
+        break;
+    }
+
+    return QVariant();
+}
+
+void TopProcessModel::setProcesses(const QVector<ProcessInfo> &processes)
+{
+    const QVector<TopKTracker::RankChange> &changes = m_tracker.update(processes);
+    const QVector<ProcessInfo> &ranked = m_tracker.entries();
+
+    // Replay the edit script so selections and scroll position follow rows
+    for (const TopKTracker::RankChange &change : changes) {
+        switch (change.type) {
+        case TopKTracker::RankChange::Remove:
+            beginRemoveRows(QModelIndex(), change.from, change.from);
+            m_rows.remove(change.from);
+            endRemoveRows();
+            break;
+        case TopKTracker::RankChange::Move:
+            // Moving up: the destination is the row it lands before
+            beginMoveRows(QModelIndex(), change.from, change.from, QModelIndex(), change.to);
+            m_rows.move(change.from, change.to);
+            endMoveRows();
+            break;
+        case TopKTracker::RankChange::Insert:
+            beginInsertRows(QModelIndex(), change.to, change.to);
+            m_rows.insert(change.to, ranked.at(change.to));
+            endInsertRows();
+            break;
+        }
+    }
+
+    // Rows now match the ranking - refresh every value in one range
+    m_rows = ranked;
+    if (!m_rows.isEmpty()) {
+        emit dataChanged(index(0, 0), index(m_rows.size() - 1, ColumnCount - 1),
+                         {Qt::DisplayRole});
+    }
+}
+
+QString TopProcessModel::formatValue(const ProcessInfo &process) const
+{
+    switch (m_tracker.key()) {
+    case TopKTracker::ByCpu:
+        return QString::number(process.cpuUsage, 'f', 1) + " %";
+    case TopKTracker::ByMemory:
+        return MemoryMonitor::formatBytes(process.rss);
+    case TopKTracker::ByIo:
+        return MemoryMonitor::formatBytes(qint64(process.ioRate())) + "/s";
+    }
+    return QString();
+}
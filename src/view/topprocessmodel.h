@@ -0,0 +1,37 @@
+#ifndef TOPPROCESSMODEL_H
+#define TOPPROCESSMODEL_H
+
+#include <QAbstractTableModel>
+#include "../model/topktracker.h"
+
+// Table of the top-k processes for one ranking key. Ranking changes reach
+// the view as row removes/moves/inserts; values as one dataChanged range.
+class TopProcessModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    enum Column {
+        PidColumn,
+        NameColumn,
+        ValueColumn,    // The ranking key (CPU %, RSS or I/O rate)
+        ColumnCount
+    };
+
+    explicit TopProcessModel(TopKTracker::RankKey key, int capacity, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    // Feed one process scan
+    void setProcesses(const QVector<ProcessInfo> &processes);
+
+private:
+    QString formatValue(const ProcessInfo &process) const;
+
+    TopKTracker m_tracker;
+    QVector<ProcessInfo> m_rows;    // What the view currently shows
+};
+
+#endif // TOPPROCESSMODEL_H
@@ -177,8 +177,26 @@ void MetricCard::setColor(const QColor &color)
 
 void MetricCard::setSubtitle(const QString &subtitle)
 {
-    m_subtitleLabel->setText(subtitle);
-    m_subtitleLabel->setVisible(!subtitle.isEmpty());
+    m_subtitle = subtitle;
+    updateSubtitleLabel();
+}
+
+void MetricCard::setSecondary(const QString &secondary)
+{
+    m_secondary = secondary;
+    updateSubtitleLabel();
+}
+
+void MetricCard::updateSubtitleLabel()
+{
+    // Monitors and the window aggregates update independently
+    QString text = m_subtitle;
+    if (!m_secondary.isEmpty()) {
+        text += text.isEmpty() ? m_secondary : " | " + m_secondary;
+    }
+
+    m_subtitleLabel->setText(text);
+    m_subtitleLabel->setVisible(!text.isEmpty());
 }
 
 void MetricCard::setValue(double value)
@@ -26,6 +26,8 @@ public:
     void setIcon(const QString &iconPath);
     void setColor(const QColor &color);
     void setSubtitle(const QString &subtitle);
+    // Appended to the subtitle, e.g. window aggregates ("avg 1m: 42%")
+    void setSecondary(const QString &secondary);
 
     // Value updates
     void setValue(double value);                    // CircularType
@@ -43,6 +45,7 @@ private:
     void setupTextLayout();
     void setupNetworkLayout();
     void applyCardStyling();
+    void updateSubtitleLabel();
 
 private:
     CardType m_type;
@@ -56,6 +59,8 @@ private:
     QLabel *m_iconLabel;
     QLabel *m_titleLabel;
     QLabel *m_subtitleLabel;
+    QString m_subtitle;
+    QString m_secondary;
 
     // Content widgets
     CircularProgress *m_circularProgress = nullptr;  // CircularType
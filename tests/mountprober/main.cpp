@@ -0,0 +1,232 @@
+// MountProber against mounts that stall, the way a FUSE or NFS mount does
+// when its server stops answering.
+//
+//   mountprober_stall              scripted stand-in: statvfs() replaced by a
+//                                  probe that blocks until released
+//   mountprober_stall <path>...    real statvfs() on the given mounts for 30 s,
+//                                  e.g. a FUSE mount whose daemon was SIGSTOPped
+//
+// The scripted run exits non-zero if a check fails.
+
+#include "mountprober.h"
+#include <QByteArray>
+#include <QSet>
+#include <QVector>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+namespace {
+    const int WORKERS = 2;
+    const int MAX_THREADS = 6;
+    const int DEADLINE_MS = 100;
+    const int MAX_BACKOFF_MS = 1600;
+    const int TICK_MS = 50;
+
+    int s_failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::printf("FAIL line %d: %s\n", __LINE__, #condition); \
+            ++s_failures; \
+        } \
+    } while (0)
+
+    // Stand-in filesystem: paths in the stalled set block until released
+    class StallingFilesystem
+    {
+    public:
+        MountProbe probe(const QByteArray &path)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_released.wait(lock, [this, &path]() {
+                return !m_stalled.contains(path);
+            });
+
+            MountProbe result;
+            result.ok = true;
+            result.totalBytes = 1000;
+            result.usedBytes = 400;
+            result.availableBytes = 600;
+            return result;
+        }
+
+        void stall(const QByteArray &path)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stalled.insert(path);
+        }
+
+        void releaseAll()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stalled.clear();
+            m_released.notify_all();
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_released;
+        QSet<QByteArray> m_stalled;
+    };
+
+    qint64 elapsedUs(std::chrono::steady_clock::time_point since)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - since).count();
+    }
+
+    // Calls probe() once per tick for durationMs; returns the slowest call (us)
+    qint64 runTicks(MountProber &prober, const QVector<QByteArray> &paths,
+                    QVector<MountProbe> &results, int durationMs)
+    {
+        qint64 slowest = 0;
+        for (int elapsed = 0; elapsed < durationMs; elapsed += TICK_MS) {
+            const auto start = std::chrono::steady_clock::now();
+            prober.probe(paths, results);
+            slowest = qMax(slowest, elapsedUs(start));
+            std::this_thread::sleep_for(std::chrono::milliseconds(TICK_MS));
+        }
+        return slowest;
+    }
+
+    // Hung mounts queued ahead of healthy ones, more of them than workers
+    void testHungMountsDoNotStarveHealthyOnes()
+    {
+        std::printf("hung mounts ahead of healthy ones\n");
+
+        StallingFilesystem filesystem;
+        int firstResults = 0;
+        std::mutex counterMutex;
+
+        QVector<QByteArray> paths;
+        for (int i = 0; i < 4; ++i) {
+            paths.append("/hung" + QByteArray::number(i));
+            filesystem.stall(paths.last());
+        }
+        for (int i = 0; i < 6; ++i) {
+            paths.append("/ok" + QByteArray::number(i));
+        }
+
+        QVector<MountProbe> results;
+        {
+            MountProber prober(WORKERS, MAX_THREADS, DEADLINE_MS, MAX_BACKOFF_MS,
+                               [&filesystem](const QByteArray &path) {
+                                   return filesystem.probe(path);
+                               });
+            prober.setFirstResultCallback([&]() {
+                std::lock_guard<std::mutex> lock(counterMutex);
+                ++firstResults;
+            });
+
+            const qint64 slowest = runTicks(prober, paths, results, 1000);
+            std::printf("  slowest probe() call while stalled: %lld us\n", static_cast<long long>(slowest));
+            CHECK(slowest < 5000);
+
+            for (int i = 0; i < 4; ++i) {
+                CHECK(results[i].stale);
+                CHECK(!results[i].ok);
+            }
+            for (int i = 4; i < paths.size(); ++i) {
+                CHECK(results[i].ok);
+                CHECK(!results[i].stale);
+            }
+            CHECK(prober.quarantinedCount() == 4);
+            CHECK(prober.threadCount() == qMin(WORKERS + 4, MAX_THREADS));
+            std::printf("  %d quarantined, %d threads\n", prober.quarantinedCount(), prober.threadCount());
+
+            // Server back: answers after the backoff, then healthy again
+            filesystem.releaseAll();
+            runTicks(prober, paths, results, 2 * MAX_BACKOFF_MS);
+
+            for (const MountProbe &result : results) {
+                CHECK(result.ok);
+                CHECK(!result.stale);
+            }
+            CHECK(prober.quarantinedCount() == 0);
+            CHECK(prober.threadCount() == WORKERS);
+            std::printf("  after release: %d quarantined, %d threads\n",
+                        prober.quarantinedCount(), prober.threadCount());
+
+            prober.setFirstResultCallback(nullptr);
+        }
+
+        CHECK(firstResults == paths.size());
+    }
+
+    // More hung mounts than the thread bound allows: healthy ones are late
+    // (stale) but never quarantined, and the pool stays bounded
+    void testThreadBound()
+    {
+        std::printf("more hung mounts than threads\n");
+
+        StallingFilesystem filesystem;
+        QVector<QByteArray> paths;
+        for (int i = 0; i < MAX_THREADS + 2; ++i) {
+            paths.append("/hung" + QByteArray::number(i));
+            filesystem.stall(paths.last());
+        }
+        paths.append("/ok");
+
+        QVector<MountProbe> results;
+        MountProber prober(WORKERS, MAX_THREADS, DEADLINE_MS, MAX_BACKOFF_MS,
+                           [&filesystem](const QByteArray &path) {
+                               return filesystem.probe(path);
+                           });
+
+        const qint64 slowest = runTicks(prober, paths, results, 1000);
+        std::printf("  slowest probe() call: %lld us, %d threads, %d quarantined\n",
+                    static_cast<long long>(slowest), prober.threadCount(), prober.quarantinedCount());
+        CHECK(slowest < 5000);
+        CHECK(prober.threadCount() == MAX_THREADS);
+        CHECK(prober.quarantinedCount() == MAX_THREADS);
+        CHECK(results.last().stale);
+
+        filesystem.releaseAll();
+        runTicks(prober, paths, results, 2 * MAX_BACKOFF_MS);
+        CHECK(results.last().ok);
+        CHECK(!results.last().stale);
+    }
+
+    int probeRealMounts(const QVector<QByteArray> &paths)
+    {
+        MountProber prober(WORKERS, MAX_THREADS, 500, 300000);
+        QVector<MountProbe> results;
+
+        for (int second = 0; second < 30; ++second) {
+            const auto start = std::chrono::steady_clock::now();
+            prober.probe(paths, results);
+            const qint64 took = elapsedUs(start);
+
+            std::printf("%2ds probe() %5lld us, %d threads, %d quarantined:", second,
+                        static_cast<long long>(took), prober.threadCount(), prober.quarantinedCount());
+            for (int i = 0; i < paths.size(); ++i) {
+                std::printf(" %s=%s", paths[i].constData(),
+                            results[i].stale ? "stale" : results[i].ok ? "ok" : "-");
+            }
+            std::printf("\n");
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1) {
+        QVector<QByteArray> paths;
+        for (int i = 1; i < argc; ++i) {
+            paths.append(QByteArray(argv[i]));
+        }
+        return probeRealMounts(paths);
+    }
+
+    testHungMountsDoNotStarveHealthyOnes();
+    testThreadBound();
+
+    std::printf(s_failures ? "%d checks failed\n" : "all checks passed\n", s_failures);
+    return s_failures ? 1 : 0;
+}
@@ -0,0 +1,16 @@
+QT       -= gui
+QT       += core
+
+CONFIG += c++14 console thread
+CONFIG -= app_bundle
+
+TARGET = mountprober_stall
+
+INCLUDEPATH += ../../src/core
+
+SOURCES += \
+    main.cpp \
+    ../../src/core/mountprober.cpp
+
+HEADERS += \
+    ../../src/core/mountprober.h
@@ -0,0 +1,6 @@
+# Standalone tests, built apart from the application:
+#   qmake tests/tests.pro && make
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    mountprober